@@ -4,6 +4,7 @@
 #include "output/formatting.h"
 #include "problem/debug.h"
 #include "problem/problem.h"
+#include <algorithm>
 
 // Constraint handler properties
 #define CONSHDLR_NAME          "edge_branching"
@@ -16,14 +17,40 @@
 #define CONSHDLR_DELAYPROP false          // should propagation method be delayed, if other propagators found reductions?
 #define CONSHDLR_NEEDSCONS true           // should the constraint handler be skipped, if no constraints are available?
 
+// Constraints added during pricing, such as arcs eliminated by reduced cost, are also propagated after the LP loop so
+// that their columns are fixed before branching
+#ifdef USE_ARC_ELIMINATION
+#define CONSHDLR_PROP_TIMING (SCIP_PROPTIMING_BEFORELP | SCIP_PROPTIMING_AFTERLPLOOP)
+#else
 #define CONSHDLR_PROP_TIMING SCIP_PROPTIMING_BEFORELP
+#endif
+
+// Constraint handler data
+struct EdgeBranchingConshdlrData
+{
+    Vertex depot;                                     // Depot
+    Vector<SCIP_Cons*> active_conss;                  // Active constraints in the order of activation
+    Vector<EdgeBranchingDecision> active_decisions;   // Decisions of the active constraints
+    Matrix<Int16> num_disabling_decisions;            // Number of active decisions disabling each arc
+    UInt64 version;                                   // Incremented whenever the active decisions change
+
+    EdgeBranchingConshdlrData(const Instance& instance) :
+        depot(instance.depot()),
+        active_conss(),
+        active_decisions(),
+        num_disabling_decisions(instance.num_vertices(), instance.num_vertices(), 0),
+        version(0)
+    {
+    }
+};
 
 // Constraint data
 struct EdgeBranchingConsData
 {
     SCIP_Node* node;         // The node of the branch-and-bound tree for this constraint
-    Edge edge;               // Decision
-    BranchDirection dir;     // Branch direction
+    Edge* edges;             // Decisions, which are only more than one for the arcs eliminated in a node
+    Size num_edges;          // Number of decisions
+    BranchDirection dir;     // Branch direction of every decision
     Size npropagatedvars;    // Number of variables that existed when the related node was propagated the last time.
                              // Used to determine whether the constraint should be repropagated
     Bool propagated;         // Is the constraint already propagated?
@@ -34,20 +61,23 @@ static SCIP_Retcode consdataCreate(
     SCIP* scip,                          // SCIP
     EdgeBranchingConsData** consdata,    // Pointer to the constraint data
     SCIP_Node* node,                     // Node of the branch-and-bound tree for this constraint
-    const Edge edge,                     // Edge
+    const Span<const Edge> edges,        // Edges
     const BranchDirection dir            // Branch direction
 )
 {
     // Check.
     debug_assert(scip);
     debug_assert(consdata);
+    debug_assert(!edges.empty());
+    debug_assert(edges.size() == 1 || dir == BranchDirection::Forbid);
 
     // Create constraint data.
     SCIP_CALL(SCIPallocBlockMemory(scip, consdata));
 
     // Store data.
     (*consdata)->node = node;
-    (*consdata)->edge = edge;
+    SCIP_CALL(SCIPduplicateBlockMemoryArray(scip, &(*consdata)->edges, edges.data(), edges.size()));
+    (*consdata)->num_edges = edges.size();
     (*consdata)->dir = dir;
     (*consdata)->npropagatedvars = 0;
     (*consdata)->propagated = false;
@@ -57,9 +87,9 @@ static SCIP_Retcode consdataCreate(
 }
 
 Bool edge_branching_check_disable_path(
-    const Edge edge,              // Decision
-    const BranchDirection dir,    // Branch direction
-    const Vector<Vertex>& path    // Path
+    const Edge edge,                 // Decision
+    const BranchDirection dir,       // Branch direction
+    const Span<const Vertex> path    // Path
 )
 {
     // If an edge must be used, disable the path if exactly one of the two vertices in the edge is used.
@@ -120,18 +150,82 @@ Bool edge_branching_check_disable_path(
     return false;
 }
 
+Bool edge_branching_check_disable_var(
+    const Edge edge,              // Decision
+    const BranchDirection dir,    // Branch direction
+    const PathVariables& vars,    // Path variables
+    const Size v                  // Variable
+)
+{
+    // A path can only violate a forbidden arc if it uses the arc, and a required arc if it visits a customer of the
+    // arc. The depot is not in the bitmask of customers.
+    if (dir == BranchDirection::Forbid)
+    {
+        if (!vars.may_use_arc(v, edge.i, edge.j))
+        {
+            return false;
+        }
+    }
+    else if (!vars.visits(v, edge.i) && !vars.visits(v, edge.j))
+    {
+        return false;
+    }
+    return edge_branching_check_disable_path(edge, dir, vars.path(v));
+}
+
+// Count the arcs disabled by a decision
+static void update_disabled_arcs(
+    EdgeBranchingConshdlrData& conshdlrdata,    // Constraint handler data
+    const EdgeBranchingDecision decision,       // Decision
+    const Int16 change                          // +1 when activating the decision and -1 when deactivating it
+)
+{
+    // Get the arcs.
+    auto& num_disabling_decisions = conshdlrdata.num_disabling_decisions;
+    const auto num_vertices = num_disabling_decisions.rows();
+    const auto depot = conshdlrdata.depot;
+    const auto [edge, dir] = decision;
+
+    // If an edge must not be used, disable the edge. If an edge must be used, disable all other edges entering j and
+    // leaving i, except at the depot.
+    if (dir == BranchDirection::Forbid)
+    {
+        num_disabling_decisions(edge.i, edge.j) += change;
+    }
+    else
+    {
+        if (edge.j != depot)
+        {
+            for (Vertex i = 0; i < num_vertices; ++i)
+                if (i != edge.i)
+                {
+                    num_disabling_decisions(i, edge.j) += change;
+                }
+        }
+        if (edge.i != depot)
+        {
+            for (Vertex j = 0; j < num_vertices; ++j)
+                if (j != edge.j)
+                {
+                    num_disabling_decisions(edge.i, j) += change;
+                }
+        }
+    }
+}
+
 // Fix a variable to zero if its path is not valid for this constraint/branch
 static inline SCIP_Retcode check_variable(
     SCIP* scip,                      // SCIP
     const Edge edge,                 // Decision
     const BranchDirection dir,       // Branch direction
-    const PathVariable& path_var,    // Variable to check
+    const PathVariables& vars,       // Path variables
+    const Size v,                    // Variable to check
     Size& nfixedvars,                // Pointer to store the number of fixed variables
     SCIP_Bool* cutoff                // Pointer to store if a cutoff was detected
 )
 {
     // Get the path variable.
-    const auto& [var, _, path] = path_var;
+    const auto& [var, _, path] = vars[v];
 
     // Check.
     debug_assert(scip);
@@ -140,6 +234,13 @@ static inline SCIP_Retcode check_variable(
     debug_assert(path.front() == reinterpret_cast<Problem*>(SCIPgetProbData(scip))->instance->depot());
     debug_assert(path.back() == reinterpret_cast<Problem*>(SCIPgetProbData(scip))->instance->depot());
 
+    // If the variable is deleted from the master problem, it cannot be fixed. Its path is added again as a new
+    // variable, which is checked separately.
+    if (SCIPvarIsDeleted(var))
+    {
+        return SCIP_OKAY;
+    }
+
     // If the variable is locally fixed to zero, continue to next variable.
     if (SCIPvarGetUbLocal(var) < 0.5)
     {
@@ -147,7 +248,7 @@ static inline SCIP_Retcode check_variable(
     }
 
     // Disable the variable if its path doesn't satisfy the branching decision.
-    if (edge_branching_check_disable_path(edge, dir, path))
+    if (edge_branching_check_disable_var(edge, dir, vars, v))
     {
         // Disable the variable.
         SCIP_Bool success;
@@ -179,11 +280,32 @@ static inline SCIP_Retcode check_variable(
     return SCIP_OKAY;
 }
 
+// Check the variables in a list of the inverted index that were added since the last propagation
+static SCIP_Retcode check_indexed_variables(
+    SCIP* scip,                          // SCIP
+    EdgeBranchingConsData* consdata,     // Constraint data
+    const Edge edge,                     // Decision of the constraint
+    const PathVariables& vars,           // Path variables
+    const Vector<Size>& indexed_vars,    // Variables using an arc or a customer, in increasing order
+    Size& nfixedvars,                    // Pointer to store the number of fixed variables
+    SCIP_Bool* cutoff                    // Pointer to store if a cutoff was detected
+)
+{
+    auto it = std::lower_bound(indexed_vars.begin(), indexed_vars.end(), consdata->npropagatedvars);
+    for (; it != indexed_vars.end() && !*cutoff; ++it)
+    {
+        debug_assert(*it < vars.size());
+        SCIP_CALL(check_variable(scip, edge, consdata->dir, vars, *it, nfixedvars, cutoff));
+    }
+    return SCIP_OKAY;
+}
+
 // Fix variables to zero if its path is not valid for this constraint/branching
 static SCIP_Retcode fix_variables(
     SCIP* scip,                          // SCIP
     EdgeBranchingConsData* consdata,     // Constraint data
-    const Vector<PathVariable>& vars,    // Array of variables
+    const PathVariables& vars,           // Path variables
+    const Vertex depot,                  // Depot
     SCIP_Result* result                  // Pointer to store the result of the fixing
 )
 {
@@ -191,16 +313,33 @@ static SCIP_Retcode fix_variables(
     debugln("        Checking variables {} to {}:", consdata->npropagatedvars, vars.size());
 
     // Check.
-    const auto nvars = vars.size();
-    debug_assert(consdata->npropagatedvars <= nvars);
+    debug_assert(consdata->npropagatedvars <= vars.size());
 
-    // Check every variable.
+    // Check the variables that can violate the decisions. Only the paths using the arc violate a forbidden arc. A
+    // required arc is only violated by paths visiting one of its customers.
     Size nfixedvars = 0;
     SCIP_Bool cutoff = false;
-    for (Size v = consdata->npropagatedvars; v < nvars && !cutoff; ++v)
+    for (Size e = 0; e < consdata->num_edges && !cutoff; ++e)
     {
-        debug_assert(v < nvars);
-        SCIP_CALL(check_variable(scip, consdata->edge, consdata->dir, vars[v], nfixedvars, &cutoff));
+        const auto edge = consdata->edges[e];
+        if (consdata->dir == BranchDirection::Forbid)
+        {
+            const auto& arc_vars = vars.arc_vars(edge.i, edge.j);
+            SCIP_CALL(check_indexed_variables(scip, consdata, edge, vars, arc_vars, nfixedvars, &cutoff));
+        }
+        else
+        {
+            if (edge.i != depot)
+            {
+                const auto& customer_vars = vars.customer_vars(edge.i);
+                SCIP_CALL(check_indexed_variables(scip, consdata, edge, vars, customer_vars, nfixedvars, &cutoff));
+            }
+            if (edge.j != depot && !cutoff)
+            {
+                const auto& customer_vars = vars.customer_vars(edge.j);
+                SCIP_CALL(check_indexed_variables(scip, consdata, edge, vars, customer_vars, nfixedvars, &cutoff));
+            }
+        }
     }
 
     // Print.
@@ -231,8 +370,7 @@ static void check_propagation(
     const auto nvars = beforeprop ? consdata->npropagatedvars : vars.size();
     release_assert(nvars <= vars.size());
 
-    // Get the branching decision.
-    const auto edge = consdata->edge;
+    // Get the branching decisions.
     const auto dir = consdata->dir;
 
     // Check that the path of every variable is feasible for this constraint.
@@ -242,8 +380,8 @@ static void check_propagation(
         debug_assert(v < vars.size());
         const auto& [var, _, path] = vars[v];
 
-        // If the variable is locally fixed to zero, continue.
-        if (SCIPvarGetUbLocal(var) < 0.5)
+        // If the variable is deleted or locally fixed to zero, continue.
+        if (SCIPvarIsDeleted(var) || SCIPvarGetUbLocal(var) < 0.5)
         {
             continue;
         }
@@ -254,14 +392,58 @@ static void check_propagation(
         debug_assert(path.back() == problem.instance->depot());
 #endif
 
-        // Check.
-        release_assert(!edge_branching_check_disable_path(edge, dir, path),
-                       "Branching decision is not propagated correctly for path {}",
-                       format_path(path));
+        // Check by walking the path so that the signatures of the variables are also checked.
+        for (Size e = 0; e < consdata->num_edges; ++e)
+        {
+            release_assert(!edge_branching_check_disable_path(consdata->edges[e], dir, path),
+                           "Branching decision is not propagated correctly for path {}",
+                           format_path(path));
+        }
     }
 }
 #endif
 
+// Free constraint handler data
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+static SCIP_DECL_CONSFREE(consFreeEdgeBranching)
+{
+    // Check.
+    debug_assert(conshdlr);
+    debug_assert(strcmp(SCIPconshdlrGetName(conshdlr), CONSHDLR_NAME) == 0);
+
+    // Free memory.
+    auto conshdlrdata = reinterpret_cast<EdgeBranchingConshdlrData*>(SCIPconshdlrGetData(conshdlr));
+    debug_assert(conshdlrdata);
+    delete conshdlrdata;
+    SCIPconshdlrSetData(conshdlr, nullptr);
+
+    // Done.
+    return SCIP_OKAY;
+}
+#pragma GCC diagnostic pop
+
+// Clear the active decisions before the branch-and-bound process starts
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+static SCIP_DECL_CONSINITSOL(consInitsolEdgeBranching)
+{
+    // Check.
+    debug_assert(conshdlr);
+    debug_assert(strcmp(SCIPconshdlrGetName(conshdlr), CONSHDLR_NAME) == 0);
+
+    // Clear.
+    auto& conshdlrdata = *reinterpret_cast<EdgeBranchingConshdlrData*>(SCIPconshdlrGetData(conshdlr));
+    conshdlrdata.active_conss.clear();
+    conshdlrdata.active_decisions.clear();
+    conshdlrdata.num_disabling_decisions.set(0);
+    ++conshdlrdata.version;
+
+    // Done.
+    return SCIP_OKAY;
+}
+#pragma GCC diagnostic pop
+
 // Free constraint data
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-parameter"
@@ -274,7 +456,9 @@ static SCIP_DECL_CONSDELETE(consDeleteEdgeBranching)
     debug_assert(*consdata);
 
     // Free memory.
-    SCIPfreeBlockMemory(scip, reinterpret_cast<EdgeBranchingConsData**>(consdata));
+    auto data = reinterpret_cast<EdgeBranchingConsData**>(consdata);
+    SCIPfreeBlockMemoryArray(scip, &(*data)->edges, (*data)->num_edges);
+    SCIPfreeBlockMemory(scip, data);
 
     // Done.
     return SCIP_OKAY;
@@ -297,7 +481,11 @@ static SCIP_DECL_CONSTRANS(consTransEdgeBranching)
 
     // Create constraint data for target constraint.
     EdgeBranchingConsData* targetdata;
-    SCIP_CALL(consdataCreate(scip, &targetdata, sourcedata->node, sourcedata->edge, sourcedata->dir));
+    SCIP_CALL(consdataCreate(scip,
+                             &targetdata,
+                             sourcedata->node,
+                             Span<const Edge>(sourcedata->edges, sourcedata->num_edges),
+                             sourcedata->dir));
     debug_assert(targetdata);
 
     // Create target constraint.
@@ -358,11 +546,12 @@ static SCIP_DECL_CONSPROP(consPropEdgeBranching)
             // Print.
 #ifdef PRINT_DEBUG
             {
-                debugln("    Propagating edge branching constraint branch_{}({},{}) from node {} at depth {} in node {}"
-                        " at depth {}",
+                debugln("    Propagating edge branching constraint branch_{}({},{}) with {} edges from node {} at depth {}"
+                        " in node {} at depth {}",
                         consdata->dir,
-                        consdata->edge.i,
-                        consdata->edge.j,
+                        consdata->edges[0].i,
+                        consdata->edges[0].j,
+                        consdata->num_edges,
                         SCIPnodeGetNumber(consdata->node),
                         SCIPnodeGetDepth(consdata->node),
                         SCIPnodeGetNumber(SCIPgetCurrentNode(scip)),
@@ -371,7 +560,7 @@ static SCIP_DECL_CONSPROP(consPropEdgeBranching)
 #endif
 
             // Propagate.
-            SCIP_CALL(fix_variables(scip, consdata, vars, result));
+            SCIP_CALL(fix_variables(scip, consdata, vars, problem.instance->depot(), result));
 
             // Set status.
             if (*result != SCIP_CUTOFF)
@@ -419,15 +608,30 @@ static SCIP_DECL_CONSACTIVE(consActiveEdgeBranching)
     debug_assert(consdata->npropagatedvars <= vars.size());
 
     // Print.
-    debugln("    Activating edge branching constraint branch_{}({},{}) from node {} at depth {} in node {} at depth {}",
+    debugln("    Activating edge branching constraint branch_{}({},{}) with {} edges from node {} at depth {} in node {} "
+            "at depth {}",
             consdata->dir,
-            consdata->edge.i,
-            consdata->edge.j,
+            consdata->edges[0].i,
+            consdata->edges[0].j,
+            consdata->num_edges,
             SCIPnodeGetNumber(consdata->node),
             SCIPnodeGetDepth(consdata->node),
             SCIPnodeGetNumber(SCIPgetCurrentNode(scip)),
             SCIPgetDepth(scip));
 
+    // Push the decisions onto the stack of active decisions.
+    {
+        auto& conshdlrdata = *reinterpret_cast<EdgeBranchingConshdlrData*>(SCIPconshdlrGetData(conshdlr));
+        for (Size e = 0; e < consdata->num_edges; ++e)
+        {
+            const EdgeBranchingDecision decision{consdata->edges[e], consdata->dir};
+            conshdlrdata.active_conss.push_back(cons);
+            conshdlrdata.active_decisions.push_back(decision);
+            update_disabled_arcs(conshdlrdata, decision, 1);
+        }
+        ++conshdlrdata.version;
+    }
+
     // Mark constraint as to be repropagated.
     if (consdata->npropagatedvars != vars.size())
     {
@@ -462,10 +666,34 @@ static SCIP_DECL_CONSDEACTIVE(consDeactiveEdgeBranching)
     debug_assert(consdata->propagated || SCIPgetNChildren(scip) == 0);
 
     // Print.
-    debugln("    Deactivating edge branching constraint branch_{}({},{})",
+    debugln("    Deactivating edge branching constraint branch_{}({},{}) with {} edges",
             consdata->dir,
-            consdata->edge.i,
-            consdata->edge.j);
+            consdata->edges[0].i,
+            consdata->edges[0].j,
+            consdata->num_edges);
+
+    // Remove the decisions from the stack of active decisions. SCIP deactivates constraints in the reverse order of
+    // activation, so the constraint is normally on top. The decisions of a constraint are contiguous.
+    {
+        auto& conshdlrdata = *reinterpret_cast<EdgeBranchingConshdlrData*>(SCIPconshdlrGetData(conshdlr));
+        auto& active_conss = conshdlrdata.active_conss;
+        auto& active_decisions = conshdlrdata.active_decisions;
+        const auto it = std::find(active_conss.rbegin(), active_conss.rend(), cons);
+        release_assert(it != active_conss.rend(), "Deactivating edge branching constraint that is not active");
+        const auto end = active_conss.rend() - it;
+        const auto begin = end - consdata->num_edges;
+        debug_assert(begin >= 0);
+        debug_assert(std::all_of(active_conss.begin() + begin,
+                                 active_conss.begin() + end,
+                                 [cons](const SCIP_Cons* other) { return other == cons; }));
+        for (auto idx = begin; idx < end; ++idx)
+        {
+            update_disabled_arcs(conshdlrdata, active_decisions[idx], -1);
+        }
+        active_conss.erase(active_conss.begin() + begin, active_conss.begin() + end);
+        active_decisions.erase(active_decisions.begin() + begin, active_decisions.begin() + end);
+        ++conshdlrdata.version;
+    }
 
     // Set the number of propagated variables to the current number of variables.
     consdata->npropagatedvars = vars.size();
@@ -477,9 +705,13 @@ static SCIP_DECL_CONSDEACTIVE(consDeactiveEdgeBranching)
 
 // Create the constraint handler for a branch and include it
 SCIP_Retcode SCIPincludeConshdlrEdgeBranching(
-    SCIP* scip    // SCIP
+    SCIP* scip,                  // SCIP
+    const Instance& instance     // Instance
 )
 {
+    // Create constraint handler data.
+    auto conshdlrdata = new EdgeBranchingConshdlrData(instance);
+
     // Include constraint handler.
     SCIP_Conshdlr* conshdlr = nullptr;
     SCIP_CALL(SCIPincludeConshdlrBasic(scip,
@@ -494,10 +726,12 @@ SCIP_Retcode SCIPincludeConshdlrEdgeBranching(
                                        nullptr,
                                        nullptr,
                                        nullptr,
-                                       nullptr));
+                                       reinterpret_cast<SCIP_ConshdlrData*>(conshdlrdata)));
     debug_assert(conshdlr);
 
     // Set callbacks.
+    SCIP_CALL(SCIPsetConshdlrFree(scip, conshdlr, consFreeEdgeBranching));
+    SCIP_CALL(SCIPsetConshdlrInitsol(scip, conshdlr, consInitsolEdgeBranching));
     SCIP_CALL(SCIPsetConshdlrDelete(scip, conshdlr, consDeleteEdgeBranching));
     SCIP_CALL(SCIPsetConshdlrTrans(scip, conshdlr, consTransEdgeBranching));
     SCIP_CALL(SCIPsetConshdlrProp(scip,
@@ -523,6 +757,20 @@ SCIP_Retcode SCIPcreateConsEdgeBranching(
     const BranchDirection dir,    // Branch direction
     SCIP_Bool local               // Is this constraint only valid locally?
 )
+{
+    return SCIPcreateConsEdgeBranching(scip, cons, name, node, Span<const Edge>(&edge, 1), dir, local);
+}
+
+// Create and capture a constraint enforcing the same branch direction on many edges
+SCIP_Retcode SCIPcreateConsEdgeBranching(
+    SCIP* scip,                       // SCIP
+    SCIP_Cons** cons,                 // Pointer to the created constraint
+    const char* name,                 // Name of constraint
+    SCIP_Node* node,                  // The node of the branch-and-bound tree for this constraint
+    const Span<const Edge> edges,     // Edges
+    const BranchDirection dir,        // Branch direction
+    SCIP_Bool local                   // Is this constraint only valid locally?
+)
 {
     // Find the constraint handler.
     auto conshdlr = SCIPfindConshdlr(scip, CONSHDLR_NAME);
@@ -530,7 +778,7 @@ SCIP_Retcode SCIPcreateConsEdgeBranching(
 
     // Create constraint data.
     EdgeBranchingConsData* consdata;
-    SCIP_CALL(consdataCreate(scip, &consdata, node, edge, dir));
+    SCIP_CALL(consdataCreate(scip, &consdata, node, edges, dir));
     debug_assert(consdata);
 
     // Create constraint.
@@ -551,10 +799,11 @@ SCIP_Retcode SCIPcreateConsEdgeBranching(
                              true));
 
     // Print.
-    debugln("    Creating edge branching constraint branch_{}({},{}) in node {} at depth {} (parent {})",
+    debugln("    Creating edge branching constraint branch_{}({},{}) with {} edges in node {} at depth {} (parent {})",
             consdata->dir,
-            consdata->edge.i,
-            consdata->edge.j,
+            consdata->edges[0].i,
+            consdata->edges[0].j,
+            consdata->num_edges,
             SCIPnodeGetNumber(consdata->node),
             SCIPnodeGetDepth(consdata->node),
             SCIPnodeGetNumber(SCIPnodeGetParent(consdata->node)));
@@ -572,8 +821,43 @@ EdgeBranchingDecision SCIPgetEdgeBranchingDecision(
     auto consdata = reinterpret_cast<EdgeBranchingConsData*>(SCIPconsGetData(cons));
     debug_assert(consdata);
 
+    debug_assert(consdata->num_edges == 1);
+
     EdgeBranchingDecision decision;
-    decision.edge = consdata->edge;
+    decision.edge = consdata->edges[0];
     decision.dir = consdata->dir;
     return decision;
 }
+
+// Get the active edge branching decisions in the order of activation
+const Vector<EdgeBranchingDecision>& SCIPgetActiveEdgeBranchingDecisions(
+    SCIP_Conshdlr* conshdlr    // Constraint handler for edge branching
+)
+{
+    debug_assert(conshdlr);
+    auto conshdlrdata = reinterpret_cast<EdgeBranchingConshdlrData*>(SCIPconshdlrGetData(conshdlr));
+    debug_assert(conshdlrdata);
+    return conshdlrdata->active_decisions;
+}
+
+// Get the number of active edge branching decisions disabling each arc
+const Matrix<Int16>& SCIPgetEdgeBranchingDisabledArcs(
+    SCIP_Conshdlr* conshdlr    // Constraint handler for edge branching
+)
+{
+    debug_assert(conshdlr);
+    auto conshdlrdata = reinterpret_cast<EdgeBranchingConshdlrData*>(SCIPconshdlrGetData(conshdlr));
+    debug_assert(conshdlrdata);
+    return conshdlrdata->num_disabling_decisions;
+}
+
+// Get a counter that changes whenever the active edge branching decisions change
+UInt64 SCIPgetEdgeBranchingVersion(
+    SCIP_Conshdlr* conshdlr    // Constraint handler for edge branching
+)
+{
+    debug_assert(conshdlr);
+    auto conshdlrdata = reinterpret_cast<EdgeBranchingConshdlrData*>(SCIPconshdlrGetData(conshdlr));
+    debug_assert(conshdlrdata);
+    return conshdlrdata->version;
+}
@@ -1,14 +1,19 @@
 #pragma once
 
 #include "branching/edge_branching.h"
+#include "problem/instance.h"
+#include "problem/path_variables.h"
 #include "problem/scip.h"
 #include "types/basic_types.h"
 #include "types/edge.h"
+#include "types/matrix.h"
+#include "types/span.h"
 #include "types/vector.h"
 
 // Create the constraint handler for a branch and include it
 SCIP_Retcode SCIPincludeConshdlrEdgeBranching(
-    SCIP* scip    // SCIP
+    SCIP* scip,                  // SCIP
+    const Instance& instance     // Instance
 );
 
 // Create and capture a constraint enforcing a branch
@@ -22,14 +27,50 @@ SCIP_Retcode SCIPcreateConsEdgeBranching(
     SCIP_Bool local               // Is this constraint only valid locally?
 );
 
+// Create and capture a constraint enforcing the same branch direction on many edges, such as the arcs eliminated in a
+// node
+SCIP_Retcode SCIPcreateConsEdgeBranching(
+    SCIP* scip,                       // SCIP
+    SCIP_Cons** cons,                 // Pointer to the created constraint
+    const char* name,                 // Name of constraint
+    SCIP_Node* node,                  // The node of the branch-and-bound tree for this constraint
+    const Span<const Edge> edges,     // Edges
+    const BranchDirection dir,        // Branch direction
+    SCIP_Bool local                   // Is this constraint only valid locally?
+);
+
 // Get edge branching decision
 EdgeBranchingDecision SCIPgetEdgeBranchingDecision(
     SCIP_Cons* cons    // Constraint enforcing edge branching
 );
 
+// Get the active edge branching decisions in the order of activation
+const Vector<EdgeBranchingDecision>& SCIPgetActiveEdgeBranchingDecisions(
+    SCIP_Conshdlr* conshdlr    // Constraint handler for edge branching
+);
+
+// Get the number of active edge branching decisions disabling each arc
+const Matrix<Int16>& SCIPgetEdgeBranchingDisabledArcs(
+    SCIP_Conshdlr* conshdlr    // Constraint handler for edge branching
+);
+
+// Get a counter that changes whenever the active edge branching decisions change
+UInt64 SCIPgetEdgeBranchingVersion(
+    SCIP_Conshdlr* conshdlr    // Constraint handler for edge branching
+);
+
 // Check if a path should be diabled according to a branching decision
 Bool edge_branching_check_disable_path(
+    const Edge edge,                 // Decision
+    const BranchDirection dir,       // Branch direction
+    const Span<const Vertex> path    // Path
+);
+
+// Check if the path of a variable should be disabled according to a branching decision, using the signatures of the
+// variable to skip walking most paths that are unaffected
+Bool edge_branching_check_disable_var(
     const Edge edge,              // Decision
     const BranchDirection dir,    // Branch direction
-    const Vector<Vertex>& path    // Path
+    const PathVariables& vars,    // Path variables
+    const Size v                  // Variable
 );
@@ -114,21 +114,11 @@ Pair<SCIP_Node*, SCIP_Node*> create_children_using_edge(
         const auto& problem = *reinterpret_cast<Problem*>(SCIPgetProbData(scip));
         const auto& instance = *problem.instance;
 
-        // Get constraints for edge branching decisions.
-        auto conshdlr = problem.edge_branching_conshdlr;
-        const auto num_edge_branching_conss = SCIPconshdlrGetNConss(conshdlr);
-        auto edge_branching_conss = SCIPconshdlrGetConss(conshdlr);
-        debug_assert(num_edge_branching_conss == 0 || edge_branching_conss);
-
         // Loop through decisions in the ancestors of this node.
-        for (Size idx = 0; idx < num_edge_branching_conss; ++idx)
+        for (const auto& decision : SCIPgetActiveEdgeBranchingDecisions(problem.edge_branching_conshdlr))
         {
-            // Get the constraint.
-            auto cons = edge_branching_conss[idx];
-            debug_assert(cons);
-
             // Check.
-            release_assert(!SCIPconsIsActive(cons) || SCIPgetEdgeBranchingDecision(cons).edge != edge,
+            release_assert(decision.edge != edge,
                            "Already branched on customer edge ({},{}) in an ancestor",
                            instance.vertex_name[edge.i],
                            instance.vertex_name[edge.j]);
@@ -152,6 +142,20 @@ Pair<SCIP_Node*, SCIP_Node*> create_children_using_edge(
             SCIPnodeGetNumber(branch_up_node),
             SCIPnodeGetNumber(branch_down_node));
 
+    // Disable the surplus variables below the root node. Removing a customer from a path could violate a branching
+    // decision, so the dual-optimal inequalities are only valid without branching.
+#ifdef USE_DUAL_OPTIMAL_INEQUALITIES
+    if (SCIPgetDepth(scip) == 0)
+    {
+        for (auto var : problem.customer_surplus_vars)
+            if (var)
+            {
+                scip_assert(SCIPchgVarUbNode(scip, branch_up_node, var, 0.0));
+                scip_assert(SCIPchgVarUbNode(scip, branch_down_node, var, 0.0));
+            }
+    }
+#endif
+
     // Create local constraints that enforce the decision in the children nodes.
     SCIP_Cons* branch_up_cons;
     SCIP_Cons* branch_down_cons;
@@ -344,9 +348,9 @@ Pair<SCIP_Node*, SCIP_Node*> create_children_using_edge(
 // #endif
 
 Bool branch_on_edge(
-    SCIP* scip,                                                     // SCIP
-    // BranchingRuleData* branchruledata,                           // Branching rule dat
-    const HashMap<Edge, Pair<SCIP_Real, Size>>& fractional_edges    // Edges with fractional value
+    SCIP* scip,                                // SCIP
+    // BranchingRuleData* branchruledata,      // Branching rule dat
+    const FractionalEdges& fractional_edges    // Edges with fractional value
 )
 {
     // Check.
@@ -361,10 +365,11 @@ Bool branch_on_edge(
     Size selected_count = 0;
     SCIP_Real selected_val = 0.0;
     debugln("    Branching candidates:");
-    for (const auto& [edge, pair] : fractional_edges)
+    for (const auto edge : fractional_edges.edges())
     {
         // Get the edge data.
-        const auto& [val, count] = pair;
+        const auto val = fractional_edges.val(edge);
+        const auto count = fractional_edges.count(edge);
 
         // Get the average pseudocosts.
         // const auto& edge_pseudocosts = pseudocosts.at(edge);
@@ -547,9 +552,10 @@ static SCIP_DECL_BRANCHEXECLP(branchExeclpEdge)
 #ifdef PRINT_DEBUG
     {
         debugln("    Fractional edges:");
-        for (const auto& [edge, pair] : fractional_edges)
+        for (const auto edge : fractional_edges.edges())
         {
-            const auto& [val, count] = pair;
+            const auto val = fractional_edges.val(edge);
+            const auto count = fractional_edges.count(edge);
             debugln("        ({},{}) ({},{}) with value {:.4f}, count {}",
                     edge.i,
                     edge.j,
@@ -567,6 +573,10 @@ static SCIP_DECL_BRANCHEXECLP(branchExeclpEdge)
     const auto success = branch_on_edge(scip, fractional_edges);
     if (success)
     {
+        // Store the duals and positive columns for the children.
+        problem.store_node_warm_start(scip);
+
+        // Done.
         *result = SCIP_BRANCHED;
         return SCIP_OKAY;
     }
@@ -0,0 +1,66 @@
+// #define PRINT_DEBUG
+
+#include "heuristics/heuristic_repair.h"
+#include "problem/debug.h"
+#include "problem/problem.h"
+
+#if defined(USE_SET_COVERING) || defined(USE_DUAL_OPTIMAL_INEQUALITIES)
+
+// Heuristic properties
+#define HEUR_NAME         "repair_covering"
+#define HEUR_DESC         "Removes the extra visits to customers covered more than once by the incumbent"
+#define HEUR_DISPCHAR     'O'
+#define HEUR_PRIORITY     -1000000
+#define HEUR_FREQ         1
+#define HEUR_FREQOFS      0
+#define HEUR_MAXDEPTH     -1
+#define HEUR_TIMING       SCIP_HEURTIMING_AFTERNODE
+#define HEUR_USESSUBSCIP  false
+
+// Repair the incumbents found after the last pricing call of a node, such as those found by the primal heuristics of
+// SCIP, so that the primal bound matches the cost of the reported solution. Only incumbents whose repaired paths are
+// already variables are repaired here. The others are repaired by the pricer, which can add variables.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+static SCIP_DECL_HEUREXEC(heurExecRepairCovering)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(heur);
+    debug_assert(result);
+
+    // Get problem.
+    auto& problem = *reinterpret_cast<Problem*>(SCIPgetProbData(scip));
+
+    // Repair the incumbent.
+    *result = problem.repair_solution(scip, heur, false) ? SCIP_FOUNDSOL : SCIP_DIDNOTFIND;
+
+    // Done.
+    return SCIP_OKAY;
+}
+#pragma GCC diagnostic pop
+
+SCIP_Retcode SCIPincludeHeurRepairCovering(SCIP* scip)
+{
+    // Include heuristic.
+    SCIP_Heur* heur = nullptr;
+    SCIP_CALL(SCIPincludeHeurBasic(scip,
+                                   &heur,
+                                   HEUR_NAME,
+                                   HEUR_DESC,
+                                   HEUR_DISPCHAR,
+                                   HEUR_PRIORITY,
+                                   HEUR_FREQ,
+                                   HEUR_FREQOFS,
+                                   HEUR_MAXDEPTH,
+                                   HEUR_TIMING,
+                                   HEUR_USESSUBSCIP,
+                                   heurExecRepairCovering,
+                                   nullptr));
+    debug_assert(heur);
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+#endif
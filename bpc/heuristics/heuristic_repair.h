@@ -0,0 +1,6 @@
+#pragma once
+
+#include "problem/scip.h"
+
+// Include heuristic repairing incumbents that cover customers more than once
+SCIP_Retcode SCIPincludeHeurRepairCovering(SCIP* scip);
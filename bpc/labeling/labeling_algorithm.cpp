@@ -3,14 +3,34 @@
 // #include <immintrin.h>
 // #include <mimalloc.h>
 #include "labeling/labeling_algorithm.h"
+#include "labeling/q_route_relaxation.h"
 #include "output/formatting.h"
-#include "problem/problem.h"
 #include "types/bitset.h"
 #include "types/float_compare.h"
+#include "types/tuple.h"
+#include <cfloat>
+#include <cmath>
+#include <limits>
 
-LabelingAlgorithm::LabelingAlgorithm(const Instance& instance) :
+#ifndef LABELING_BEAM_WIDTH
+#define LABELING_BEAM_WIDTH (20)                    // Maximum number of labels at each vertex in beam labeling
+#endif
+#ifndef LABELING_SPARSIFIED_NUM_NEIGHBOURS
+#define LABELING_SPARSIFIED_NUM_NEIGHBOURS (10)     // Number of outgoing arcs kept at each vertex in sparsified labeling
+#endif
+
+LabelingAlgorithm::LabelingAlgorithm(const Instance& instance, const LabelingMode mode) :
     instance_(instance),
-    reduced_cost_(instance.num_vertices(), instance.num_vertices()),
+    mode_(mode),
+    reduced_cost_(nullptr),
+    sparsified_reduced_cost_(),
+    completion_bounds_(nullptr),
+    path_filter_(),
+#ifdef USE_FLOAT_LABELING
+    exact_reduced_cost_(nullptr),
+    rounded_reduced_cost_(instance.num_vertices(), instance.num_vertices()),
+#endif
+    cost_tolerance_(0),
 // #ifdef USE_SUBSET_ROW_CUTS
 //     subset_row_cuts_vertices_(nullptr),
 //     subset_row_cuts_duals_(nullptr),
@@ -20,13 +40,22 @@ LabelingAlgorithm::LabelingAlgorithm(const Instance& instance) :
     storage_(),
     queue_(),
     pareto_frontier_(instance.num_customers()),
-    obj_(0)
+    num_labels_(instance.num_customers()),
+    obj_(0),
+    completed_(false),
+    num_paths_(0),
+    num_rejected_paths_(0),
+    num_iterations_(0)
 
 #ifdef DEBUG
   , verbose_(false),
     next_label_id_(0)
 #endif
 {
+    if (mode_ == LabelingMode::Sparsified)
+    {
+        sparsified_reduced_cost_.clear_and_resize(instance.num_vertices(), instance.num_vertices());
+    }
 }
 
 // #ifdef USE_SUBSET_ROW_CUTS
@@ -56,6 +85,46 @@ LabelingAlgorithm::LabelingAlgorithm(const Instance& instance) :
 // }
 // #endif
 
+void LabelingAlgorithm::sparsify(const Matrix<LabelCost>& reduced_cost)
+{
+    // Get NaN value.
+    constexpr auto nan = std::numeric_limits<LabelCost>::quiet_NaN();
+
+    // Get instance.
+    const auto num_customers = instance_.num_customers();
+    const auto num_vertices = instance_.num_vertices();
+    const auto depot = instance_.depot();
+
+    // Keep only the cheapest arcs into customers. Arcs into the depot are always kept so that every label can be
+    // closed.
+    Vector<Pair<LabelCost, Vertex>> neighbours;
+    neighbours.reserve(num_customers);
+    for (Vertex i = 0; i < num_vertices; ++i)
+    {
+        // Sort the valid arcs by reduced cost.
+        neighbours.clear();
+        for (Vertex j = 0; j < num_customers; ++j)
+            if (!std::isnan(reduced_cost(i, j)))
+            {
+                neighbours.push_back({reduced_cost(i, j), j});
+            }
+        const auto num_kept = std::min<Size>(neighbours.size(), LABELING_SPARSIFIED_NUM_NEIGHBOURS);
+        std::partial_sort(neighbours.begin(), neighbours.begin() + num_kept, neighbours.end());
+
+        // Copy the kept arcs.
+        for (Vertex j = 0; j < num_customers; ++j)
+        {
+            sparsified_reduced_cost_(i, j) = nan;
+        }
+        for (Size idx = 0; idx < num_kept; ++idx)
+        {
+            const auto j = neighbours[idx].second;
+            sparsified_reduced_cost_(i, j) = reduced_cost(i, j);
+        }
+        sparsified_reduced_cost_(i, depot) = reduced_cost(i, depot);
+    }
+}
+
 void LabelingAlgorithm::create_source_label()
 {
     // Get the depot.
@@ -109,17 +178,25 @@ Label* LabelingAlgorithm::extend_to_customer(const Label* const __restrict curre
 #endif
     next->parent = current;
     next->vertex = j;
+    next->extended = false;
     debug_assert(!next->dominated);
 
     // Calculate the resources.
     const auto i = current->vertex;
-    next->cost += reduced_cost_(i, j);
+    next->cost += (*reduced_cost_)(i, j);
     next->load += instance_.vertex_load[j];
     next->time = std::max<Time>(instance_.vertex_earliest[j], next->time + instance_.service_plus_travel(i, j));
     debug_assert(next->load <= instance_.vehicle_load_capacity);
     debug_assert(next->time <= instance_.vertex_latest[j]);
     debug_assert(next->time + instance_.service_plus_travel(j, depot) <= instance_.vertex_latest[depot]);
 
+    // Discard the label if none of its completions can have negative reduced cost.
+    if (completion_bounds_ &&
+        !is_lt(next->cost - cost_tolerance_ + completion_bounds_->completion_bound(j, next->time), 0.0))
+    {
+        return nullptr;
+    }
+
     // Update the unreachable customers.
     {
         auto next_unreachable = next->bitsets;
@@ -174,11 +251,12 @@ Label* LabelingAlgorithm::extend_to_customer(const Label* const __restrict curre
     }
 #endif
 
-    // Check dominance.
-    if (pareto_frontier_[j].add_label(next))
+    // Check dominance. Beam labeling discards the label if the vertex already has enough labels.
+    if (!(mode_ == LabelingMode::Beam && num_labels_[j] >= LABELING_BEAM_WIDTH) && pareto_frontier_[j].add_label(next))
     {
         // Commit label.
         storage_.commit_buffer();
+        ++num_labels_[j];
     }
     else
     {
@@ -207,7 +285,7 @@ Label* LabelingAlgorithm::extend_to_sink(const Label* const __restrict current)
 
     // Calculate the resources.
     const auto i = current->vertex;
-    next->cost += reduced_cost_(i, j);
+    next->cost += (*reduced_cost_)(i, j);
     debug_assert(instance_.vertex_load[j] == 0);
     next->time = std::max<Time>(instance_.vertex_earliest[j], next->time + instance_.service_plus_travel(i, j));
     debug_assert(next->time <= instance_.vertex_latest[j]);
@@ -230,8 +308,8 @@ Label* LabelingAlgorithm::extend_to_sink(const Label* const __restrict current)
     }
 #endif
 
-    // Discard the label if it is worse than previously found paths.
-    if (!is_lt(next->cost, obj_ / 1.3))
+    // Discard the label if it does not have negative reduced cost.
+    if (!is_lt(next->cost - cost_tolerance_, 0.0))
     {
         next = nullptr;
     }
@@ -241,11 +319,13 @@ Label* LabelingAlgorithm::extend_to_sink(const Label* const __restrict current)
 }
 
 void LabelingAlgorithm::solve(
-    SCIP* scip,                    // SCIP
-    Problem& problem,              // Problem
-    const Bool feasible_master,    // Indicates if the master problem is feasible
-    SCIP_Result* result,           // Output result
-    Cost* lower_bound              // Output lower bound
+    const Matrix<Cost>& reduced_cost,             // Reduced cost of every arc, NaN if disabled
+    const Bool feasible_master,                   // Indicates if the master problem is feasible
+    const LabelingBudget& budget,                 // Limits on the effort of the search
+    const Bool warm_start,                        // Reuse the labels of the previous call if the arcs are unchanged
+    const LabelingStopFunction& stop,             // Returns true if the search should stop early
+    const LabelingPathFunction& add_path,         // Receives the paths with negative reduced cost
+    const LabelingPathFunction& add_spare_path    // Receives the paths filtered out for being far from the best
 )
 {
     // Turn on debug printing.
@@ -253,13 +333,69 @@ void LabelingAlgorithm::solve(
 
     // Get instance.
     const auto num_customers = instance_.num_customers();
-    const auto depot = instance_.depot();
 
-    // Clear solver state.
+    // Round the reduced costs to single precision. The cost of a label with at most L arcs is then within
+    // L(L+1)/2 machine epsilons of the largest reduced cost from its exact cost, so labels only dominate and are only
+    // pruned beyond this tolerance, and the reduced cost of every path is recomputed in double precision.
+#ifdef USE_FLOAT_LABELING
+    {
+        const auto num_vertices = instance_.num_vertices();
+        Cost max_abs_reduced_cost = 0;
+        for (Vertex i = 0; i < num_vertices; ++i)
+            for (Vertex j = 0; j < num_vertices; ++j)
+            {
+                rounded_reduced_cost_(i, j) = static_cast<LabelCost>(reduced_cost(i, j));
+                if (!std::isnan(reduced_cost(i, j)))
+                {
+                    max_abs_reduced_cost = std::max(max_abs_reduced_cost, std::abs(reduced_cost(i, j)));
+                }
+            }
+        exact_reduced_cost_ = &reduced_cost;
+        cost_tolerance_ = FLT_EPSILON * max_abs_reduced_cost * num_vertices * (num_vertices + 1) / 2;
+    }
+    const auto& label_reduced_cost = rounded_reduced_cost_;
+#else
+    const auto& label_reduced_cost = reduced_cost;
+#endif
+
+    // Set the arcs to search.
+    if (mode_ == LabelingMode::Sparsified)
+    {
+        sparsify(label_reduced_cost);
+        reduced_cost_ = &sparsified_reduced_cost_;
+    }
+    else
+    {
+        reduced_cost_ = &label_reduced_cost;
+    }
+
+    // Clear statistics.
+    completed_ = false;
+    num_paths_ = 0;
+    num_rejected_paths_ = 0;
+    num_iterations_ = 0;
+
+    // Continue from the labels of the previous call. The labels that were never created or were discarded are not
+    // recovered, so a warm start cannot prove that no path has negative reduced cost. Fall back to a full search if
+    // it finds nothing.
+    if (warm_start && mode_ == LabelingMode::Exact && !storage_.empty())
+    {
+        warm_start_labels();
+        search(feasible_master, budget, stop, add_path, add_spare_path);
+        debugln("    Warm-started labeling found {} paths in {} iterations", num_paths_, num_iterations_);
+        if (num_paths_ > 0 || stop())
+        {
+            return;
+        }
+    }
+
+    // Clear solver state. Relaxed dominance ignores the unreachable customers by comparing zero bytes of the bitset.
     for (Vertex i = 0; i < num_customers; ++i)
     {
-        pareto_frontier_[i].reset(unreachable_size());
+        pareto_frontier_[i].reset(mode_ == LabelingMode::RelaxedDominance ? 0 : unreachable_size(),
+                                  2 * cost_tolerance_);
     }
+    std::fill(num_labels_.begin(), num_labels_.end(), 0);
     storage_.reset(label_size());
     queue_.clear();
     obj_ = 0;
@@ -267,17 +403,74 @@ void LabelingAlgorithm::solve(
     // Create the starting label.
     create_source_label();
 
+    // Search.
+    search(feasible_master, budget, stop, add_path, add_spare_path);
+
+    // Store statistics.
+    completed_ = queue_.empty();
+}
+
+void LabelingAlgorithm::warm_start_labels()
+{
+    // Get instance.
+    const auto num_customers = instance_.num_customers();
+    const auto& reduced_cost_matrix = *reduced_cost_;
+
+    // Clear solver state.
+    for (Vertex i = 0; i < num_customers; ++i)
+    {
+        pareto_frontier_[i].reset(unreachable_size(), 2 * cost_tolerance_);
+    }
+    queue_.clear();
+    obj_ = 0;
+
+    // Recompute the cost of every label in order of creation so that parents are updated before their children,
+    // and rebuild the Pareto frontiers.
+    storage_.for_each([&](void* object)
+    {
+        auto label = static_cast<Label*>(object);
+        label->dominated = false;
+        if (const auto parent = label->parent; parent)
+        {
+            const auto i = parent->vertex;
+            const auto j = label->vertex;
+            debug_assert(!std::isnan(reduced_cost_matrix(i, j)));
+            label->cost = parent->cost + reduced_cost_matrix(i, j);
+            label->dominated = !pareto_frontier_[j].add_label(label);
+        }
+    });
+
+    // Reinsert the labels that were not extended and are still not dominated.
+    storage_.for_each([&](void* object)
+    {
+        auto label = static_cast<Label*>(object);
+        if (!label->dominated && !label->extended)
+        {
+            queue_.push(label);
+        }
+    });
+}
+
+void LabelingAlgorithm::search(
+    const Bool feasible_master,                   // Indicates if the master problem is feasible
+    const LabelingBudget& budget,                 // Limits on the effort of the search
+    const LabelingStopFunction& stop,             // Returns true if the search should stop early
+    const LabelingPathFunction& add_path,         // Receives the paths with negative reduced cost
+    const LabelingPathFunction& add_spare_path    // Receives the paths filtered out for being far from the best
+)
+{
+    // Get instance.
+    const auto num_customers = instance_.num_customers();
+    const auto depot = instance_.depot();
+    const auto& reduced_cost_matrix = *reduced_cost_;
+
     // Main loop.
     Size num_new_paths = 0;
     Vector<Vertex> path;
     Size iter = 0;
     while (!(!feasible_master && num_new_paths >= 1) &&
-           !(num_new_paths >= 2000)                  &&
-           !(num_new_paths >= 100 && iter >= 1000)   &&
-           !(num_new_paths >= 50  && iter >= 5000)   &&
-           !(num_new_paths >= 20  && iter >= 10000)  &&
-           !(num_new_paths >= 1   && iter >= 20000)  &&
-           !SCIPisStopped(scip)                      &&
+           !budget.exhausted(num_new_paths, iter)    &&
+           !stop()                                   &&
            !queue_.empty())
     {
         // Pop the priority queue.
@@ -306,10 +499,11 @@ void LabelingAlgorithm::solve(
         {
             continue;
         }
+        current->extended = true;
 
         // Extend to customers.
         for (Vertex j = 0; j < num_customers; ++j)
-            if (!std::isnan(reduced_cost_(i, j)) && !get_bitset(current->bitsets, j))
+            if (!std::isnan(reduced_cost_matrix(i, j)) && !get_bitset(current->bitsets, j))
             {
                 auto next = extend_to_customer(current, j);
                 if (next)
@@ -319,15 +513,12 @@ void LabelingAlgorithm::solve(
             }
 
         // Extend to the depot.
-        if (!std::isnan(reduced_cost_(i, depot)))
+        if (!std::isnan(reduced_cost_matrix(i, depot)))
         {
             auto next = extend_to_sink(current);
             if (next)
             {
-                // Store the objective value.
-                obj_ = std::min(obj_, next->cost);
-
-                // Get the path and its cost.
+                // Get the path.
                 debug_assert(path.empty());
                 for (const Label* label = next; label; label = label->parent)
                 {
@@ -338,11 +529,42 @@ void LabelingAlgorithm::solve(
                 debug_assert(path.front() == depot);
                 debug_assert(path.back() == depot);
 
-                // Add the new path.
-                ++num_new_paths;
-                debugln("        Found {} paths with reduced cost {}: {}",
-                        num_new_paths, next->cost, format_path(path));
-                problem.add_priced_var(scip, std::move(path));
+                // Get the reduced cost of the path in double precision.
+#ifdef USE_FLOAT_LABELING
+                Cost path_reduced_cost = 0;
+                for (Size idx = 0; idx < static_cast<Size>(path.size()) - 1; ++idx)
+                {
+                    path_reduced_cost += (*exact_reduced_cost_)(path[idx], path[idx + 1]);
+                }
+#else
+                const Cost path_reduced_cost = next->cost;
+#endif
+
+                // Add the new path. Paths much worse than previously found paths are set aside. Discarded paths
+                // still bound the objective value but do not count towards the budget.
+                if (is_lt(path_reduced_cost, 0.0))
+                {
+                    const auto is_spare = !is_lt(path_reduced_cost, obj_ / 1.3);
+                    obj_ = std::min(obj_, path_reduced_cost);
+                    if (path_filter_ && path_filter_(path))
+                    {
+                        ++num_rejected_paths_;
+                        debugln("        Discarded path with reduced cost {}: {}",
+                                path_reduced_cost, format_path(path));
+                    }
+                    else if (is_spare)
+                    {
+                        add_spare_path(std::move(path), path_reduced_cost);
+                    }
+                    else
+                    {
+                        ++num_new_paths;
+                        debugln("        Found {} paths with reduced cost {}: {}",
+                                num_new_paths, path_reduced_cost, format_path(path));
+                        add_path(std::move(path), path_reduced_cost);
+                    }
+                }
+                path.clear();
             }
         }
 
@@ -350,6 +572,10 @@ void LabelingAlgorithm::solve(
         ++iter;
     }
 
+    // Store statistics.
+    num_paths_ += num_new_paths;
+    num_iterations_ += iter;
+
 #ifdef DEBUG
     if (verbose_)
     {
@@ -366,22 +592,6 @@ void LabelingAlgorithm::solve(
         // debugln("    Run time: {:.2f} seconds", get_clock(scip) - start_time);
     }
 #endif
-
-    // Set time out status.
-    *result = num_new_paths > 0 || !SCIPisStopped(scip) ? SCIP_SUCCESS : SCIP_DIDNOTRUN;
-
-    // Set lower bound.
-    if (lower_bound && feasible_master && queue_.empty() && num_new_paths > 0)
-    {
-        *lower_bound = std::max(SCIPgetLPObjval(scip) + obj_ * instance_.num_customers(), 0.0);
-#ifdef DEBUG
-        if (verbose_)
-        {
-            println("    Computed lower bound {} in node {}",
-                    *lower_bound, SCIPnodeGetNumber(SCIPgetCurrentNode(scip)));
-        }
-#endif
-    }
 }
 
 #ifdef DEBUG
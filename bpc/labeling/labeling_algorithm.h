@@ -4,11 +4,15 @@
 #include "labeling/pareto_frontier.h"
 #include "problem/debug.h"
 #include "problem/instance.h"
-#include "problem/problem.h"
-#include "problem/scip.h"
 #include "types/basic_types.h"
+#include "types/matrix.h"
 #include "types/priority_queue.h"
+#include "types/vector.h"
+#include <algorithm>
+#include <climits>
 #include <deque>
+#include <functional>
+#include <numeric>
 
 // #ifdef USE_SUBSET_ROW_CUTS
 // struct ThreeVertices
@@ -19,24 +23,60 @@
 // };
 // #endif
 
+class QRouteRelaxation;
+
 struct Label
 {
 #ifdef DEBUG
     UInt64 id;
 #endif
     const Label* parent;
-    Cost cost;
+    LabelCost cost;
     Bool dominated : 1;
-    Load load : 15;
+    Bool extended : 1;
+    Load load : 14;
     Time time;
     Vertex vertex;
     Byte bitsets[0];
 
-    static const Size base_size = DEBUG_ONLY(8 + ) 8*2 + 2*3;
-    static const Size padding = 2;
+    static const Size base_size = DEBUG_ONLY(8 + ) 8 + sizeof(LabelCost) + 2*3;
+    static const Size padding = (8 - base_size % 8) % 8;
 };
 static_assert(sizeof(Label) == Label::base_size + Label::padding);
 
+enum class LabelingMode : Byte
+{
+    Exact,               // Exact elementary labeling
+    Beam,                // Keep only the first few labels at each vertex
+    RelaxedDominance,    // Ignore the unreachable customers in the dominance check
+    Sparsified           // Only extend along the cheapest arcs out of each vertex
+};
+
+// Check if the search should stop early
+using LabelingStopFunction = std::function<Bool()>;
+
+// Output a path with negative reduced cost
+using LabelingPathFunction = std::function<void(Vector<Vertex>&& path, const Cost reduced_cost)>;
+
+// Check if a path must be discarded, for example because it is already in the master problem
+using LabelingFilterFunction = std::function<Bool(const Vector<Vertex>& path)>;
+
+struct LabelingBudget
+{
+    Size max_paths;         // Stop as soon as this many paths are found
+    Size max_iterations;    // Stop after popping this many labels if at least one path is found
+
+    // Check if the search should stop given the number of paths found and the number of labels popped
+    inline Bool exhausted(const Size num_paths, const Size iter) const
+    {
+        return (num_paths >= max_paths)                                                      ||
+               (num_paths >= std::max<Size>(max_paths / 20, 1)  && iter >= max_iterations / 20) ||
+               (num_paths >= std::max<Size>(max_paths / 40, 1)  && iter >= max_iterations / 4)  ||
+               (num_paths >= std::max<Size>(max_paths / 100, 1) && iter >= max_iterations / 2)  ||
+               (num_paths >= 1                                  && iter >= max_iterations);
+    }
+};
+
 struct LabelComparison
 {
     Bool operator()(const Label* const lhs, const Label* const rhs) const
@@ -49,7 +89,16 @@ class LabelingAlgorithm
 {
     // Instance
     const Instance& instance_;
-    Matrix<Cost> reduced_cost_;
+    const LabelingMode mode_;
+    const Matrix<LabelCost>* reduced_cost_;
+    Matrix<LabelCost> sparsified_reduced_cost_;
+    const QRouteRelaxation* completion_bounds_;
+    LabelingFilterFunction path_filter_;
+#ifdef USE_FLOAT_LABELING
+    const Matrix<Cost>* exact_reduced_cost_;
+    Matrix<LabelCost> rounded_reduced_cost_;
+#endif
+    Float cost_tolerance_;
 // #ifdef USE_SUBSET_ROW_CUTS
 //     ThreeVertices* subset_row_cuts_vertices_;
 //     Float* subset_row_cuts_duals_;
@@ -60,8 +109,15 @@ class LabelingAlgorithm
     MemoryPool storage_;
     PriorityQueue<Label*, LabelComparison> queue_;
     Vector<ParetoFrontier> pareto_frontier_;
+    Vector<Size> num_labels_;
     Cost obj_;
 
+    // Statistics of the last call
+    Bool completed_;
+    Size num_paths_;
+    Size num_rejected_paths_;
+    Size num_iterations_;
+
     // Debug
 #ifdef DEBUG
     Bool verbose_;
@@ -70,7 +126,7 @@ class LabelingAlgorithm
 
   public:
     // Constructors and destructor
-    LabelingAlgorithm(const Instance& instance);
+    LabelingAlgorithm(const Instance& instance, const LabelingMode mode = LabelingMode::Exact);
     LabelingAlgorithm() = delete;
     LabelingAlgorithm(const LabelingAlgorithm&) = delete;
     LabelingAlgorithm(LabelingAlgorithm&&) = delete;
@@ -79,12 +135,33 @@ class LabelingAlgorithm
     ~LabelingAlgorithm() = default;
 
     // Solve
-    inline auto& get_reduced_cost_matrix() { return reduced_cost_; }
 // #ifdef USE_SUBSET_ROW_CUTS
 //     void store_subset_row_duals(const Vector<ThreeVertices>& subset_row_cuts_vertices, const Vector<Float>& subset_row_cuts_duals);
 // #endif
-    void solve(SCIP* scip, Problem& problem, const Bool feasible_master, SCIP_Result* result, Cost* lower_bound);
-//     inline auto obj() const { return obj_; }
+    inline void set_completion_bounds(const QRouteRelaxation* completion_bounds)
+    {
+        completion_bounds_ = completion_bounds;
+    }
+    inline void set_path_filter(const LabelingFilterFunction& path_filter)
+    {
+        path_filter_ = path_filter;
+    }
+    void solve(const Matrix<Cost>& reduced_cost,
+               const Bool feasible_master,
+               const LabelingBudget& budget,
+               const Bool warm_start,
+               const LabelingStopFunction& stop,
+               const LabelingPathFunction& add_path,
+               const LabelingPathFunction& add_spare_path);
+
+    // Getters
+    inline auto mode() const { return mode_; }
+    inline auto obj() const { return obj_; }
+    inline auto completed() const { return completed_; }
+    inline auto num_paths() const { return num_paths_; }
+    inline auto num_rejected_paths() const { return num_rejected_paths_; }
+    inline auto num_iterations() const { return num_iterations_; }
+    inline Size num_labels() const { return std::accumulate(num_labels_.begin(), num_labels_.end(), Size{0}); }
 
     // Debug
 #ifdef DEBUG
@@ -105,7 +182,14 @@ class LabelingAlgorithm
         const auto size = ((label_size + 7) & (-8)); // Round up to next multiple of 8
         return size;
     }
+    void sparsify(const Matrix<LabelCost>& reduced_cost);
     void create_source_label();
     Label* extend_to_customer(const Label* const __restrict current, const Vertex j);
     Label* extend_to_sink(const Label* const __restrict current);
+    void warm_start_labels();
+    void search(const Bool feasible_master,
+                const LabelingBudget& budget,
+                const LabelingStopFunction& stop,
+                const LabelingPathFunction& add_path,
+                const LabelingPathFunction& add_spare_path);
 };
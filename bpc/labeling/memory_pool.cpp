@@ -1,7 +1,7 @@
 #include "labeling/memory_pool.h"
 #include "problem/debug.h"
 
-#define BLOCK_SIZE (10 * 1024 * 1024)
+#define BLOCK_SIZE (MemoryPool::block_size)
 
 MemoryPool::MemoryPool() :
     blocks_(),
@@ -8,6 +8,10 @@
 
 class MemoryPool
 {
+  public:
+    static constexpr Size block_size = 10 * 1024 * 1024;
+
+  private:
     Vector<UniquePtr<Byte[]>> blocks_;
     Size block_idx_;
     Size byte_idx_;
@@ -24,6 +28,7 @@ class MemoryPool
 
     // Getters
     inline auto object_size() const { return object_size_; }
+    inline Bool empty() const { return block_idx_ == 0 && byte_idx_ == 0; }
 
     // Get pointer to store an object
     void* get_buffer();
@@ -32,6 +37,20 @@ class MemoryPool
     // Clear all storage
     void reset(const Size object_size);
 
+    // Visit every committed object in order of allocation
+    template<class Function>
+    void for_each(Function&& function)
+    {
+        for (Size block_idx = 0; block_idx <= block_idx_; ++block_idx)
+        {
+            const auto end = block_idx < block_idx_ ? block_size - object_size_ : byte_idx_;
+            for (Size byte_idx = 0; byte_idx < end; byte_idx += object_size_)
+            {
+                function(reinterpret_cast<void*>(&(blocks_[block_idx][byte_idx])));
+            }
+        }
+    }
+
   private:
     // Allocate
     void allocate_blocks();
@@ -61,10 +61,11 @@ Bool bitset_dominates(const Byte* __restrict bitset_1, const Byte* __restrict bi
 // }
 // #endif
 
-void ParetoFrontier::reset(const Size unreachable_size)
+void ParetoFrontier::reset(const Size unreachable_size, const LabelCost cost_tolerance)
 {
     frontier_.clear();
     unreachable_size_ = unreachable_size;
+    cost_tolerance_ = cost_tolerance;
 }
 
 Bool ParetoFrontier::add_label(Label* __restrict new_label)
@@ -84,9 +85,10 @@ Bool ParetoFrontier::add_label(Label* __restrict new_label)
         const auto existing_time = existing_label->time;
         const auto existing_unreachable = existing_label->bitsets;
 
-        // Check if the existing label dominates the new label.
+        // Check if the existing label dominates the new label. Labels with single-precision costs only dominate if
+        // their cost is lower by more than the rounding error.
         const auto existing_dominates_new =
-            existing_cost <= new_cost &&
+            existing_cost + cost_tolerance_ <= new_cost &&
             existing_load <= new_load &&
             existing_time <= new_time &&
             bitset_dominates(existing_unreachable, new_unreachable, unreachable_size_);
@@ -98,7 +100,7 @@ Bool ParetoFrontier::add_label(Label* __restrict new_label)
 
         // Check if the new label dominates the existing label.
         const auto new_dominates_existing =
-            new_cost <= existing_cost &&
+            new_cost + cost_tolerance_ <= existing_cost &&
             new_time <= existing_time &&
             new_load <= existing_load &&
             bitset_dominates(new_unreachable, existing_unreachable, unreachable_size_);
@@ -9,6 +9,7 @@ class ParetoFrontier
 {
     Vector<Label*> frontier_;
     Size unreachable_size_;
+    LabelCost cost_tolerance_;
 
   public:
     // Constructors and destructor
@@ -23,7 +24,7 @@ class ParetoFrontier
 // #ifdef USE_SUBSET_ROW_CUTS
 //     void reset(const Count nb_subset_row_cuts, const Float* const subset_row_cuts_duals);
 // #else
-    void reset(const Size unreachable_size);
+    void reset(const Size unreachable_size, const LabelCost cost_tolerance = 0);
 // #endif
 
     // Query methods
@@ -0,0 +1,133 @@
+#include "labeling/pricing_capture.h"
+#include "problem/debug.h"
+#include "types/bitset.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// Identifier at the start of every capture file
+static constexpr char capture_magic[8] = {'B', 'P', 'C', 'P', 'R', 'I', 'C', 'E'};
+static constexpr UInt32 capture_version = 1;
+
+PricingCaptureWriter::PricingCaptureWriter(const String& path, const Instance& instance) :
+    path_(path),
+    file_(path, std::ios::binary | std::ios::trunc),
+    mask_((instance.num_vertices() * instance.num_vertices() + CHAR_BIT - 1) / CHAR_BIT),
+    num_calls_(0)
+{
+    release_assert(file_.good(), "Cannot open pricing capture file {}", path);
+
+    // Write the header.
+    const Int32 num_vertices = instance.num_vertices();
+    file_.write(capture_magic, sizeof(capture_magic));
+    file_.write(reinterpret_cast<const char*>(&capture_version), sizeof(capture_version));
+    file_.write(reinterpret_cast<const char*>(&num_vertices), sizeof(num_vertices));
+    file_.flush();
+    release_assert(file_.good(), "Failed to write the header of pricing capture file {}", path_);
+}
+
+PricingCaptureWriter::~PricingCaptureWriter()
+{
+    // Report a capture that could not be completed. The file is unusable past the last complete pricing problem.
+    file_.close();
+    if (file_.fail())
+    {
+        println("Failed to close pricing capture file {} after {} pricing problems", path_, num_calls_);
+    }
+}
+
+void PricingCaptureWriter::write(const Matrix<Cost>& reduced_cost,
+                                 const Bool feasible_master,
+                                 const LabelingBudget& budget)
+{
+    debug_assert(reduced_cost.rows() == reduced_cost.cols());
+    debug_assert(static_cast<Size>(mask_.size()) == (reduced_cost.size() + CHAR_BIT - 1) / CHAR_BIT);
+
+    // Write the flag and the budget.
+    const Byte feasible = feasible_master;
+    const Int64 max_paths = budget.max_paths;
+    const Int64 max_iterations = budget.max_iterations;
+    file_.write(reinterpret_cast<const char*>(&feasible), sizeof(feasible));
+    file_.write(reinterpret_cast<const char*>(&max_paths), sizeof(max_paths));
+    file_.write(reinterpret_cast<const char*>(&max_iterations), sizeof(max_iterations));
+
+    // Write the enabled arcs.
+    const auto size = static_cast<Size>(reduced_cost.size());
+    const auto data = reduced_cost.data();
+    std::fill(mask_.begin(), mask_.end(), 0);
+    for (Size idx = 0; idx < size; ++idx)
+        if (!std::isnan(data[idx]))
+        {
+            set_bitset(mask_.data(), idx);
+        }
+    file_.write(reinterpret_cast<const char*>(mask_.data()), mask_.size());
+
+    // Write the reduced cost of the enabled arcs.
+    for (Size idx = 0; idx < size; ++idx)
+        if (!std::isnan(data[idx]))
+        {
+            file_.write(reinterpret_cast<const char*>(&data[idx]), sizeof(Cost));
+        }
+    file_.flush();
+    release_assert(file_.good(),
+                   "Failed to write pricing problem {} to capture file {}, which is truncated",
+                   num_calls_, path_);
+    ++num_calls_;
+}
+
+PricingCaptureReader::PricingCaptureReader(const String& path, const Instance& instance) :
+    file_(path, std::ios::binary),
+    mask_((instance.num_vertices() * instance.num_vertices() + CHAR_BIT - 1) / CHAR_BIT)
+{
+    release_assert(file_.good(), "Cannot open pricing capture file {}", path);
+
+    // Check the header.
+    char magic[sizeof(capture_magic)];
+    UInt32 version = 0;
+    Int32 num_vertices = 0;
+    file_.read(magic, sizeof(magic));
+    file_.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file_.read(reinterpret_cast<char*>(&num_vertices), sizeof(num_vertices));
+    release_assert(file_.good() && std::memcmp(magic, capture_magic, sizeof(magic)) == 0,
+                   "File {} is not a pricing capture file", path);
+    release_assert(version == capture_version, "Pricing capture file {} has unknown version {}", path, version);
+    release_assert(num_vertices == instance.num_vertices(),
+                   "Pricing capture file {} has {} vertices but the instance has {}",
+                   path, num_vertices, instance.num_vertices());
+}
+
+Bool PricingCaptureReader::read(Matrix<Cost>& reduced_cost, Bool& feasible_master, LabelingBudget& budget)
+{
+    // Get NaN value.
+    constexpr auto nan = std::numeric_limits<Cost>::quiet_NaN();
+
+    // Read the flag and the budget.
+    Byte feasible = 0;
+    Int64 max_paths = 0;
+    Int64 max_iterations = 0;
+    file_.read(reinterpret_cast<char*>(&feasible), sizeof(feasible));
+    if (file_.eof())
+    {
+        return false;
+    }
+    file_.read(reinterpret_cast<char*>(&max_paths), sizeof(max_paths));
+    file_.read(reinterpret_cast<char*>(&max_iterations), sizeof(max_iterations));
+    feasible_master = feasible;
+    budget.max_paths = max_paths;
+    budget.max_iterations = max_iterations;
+
+    // Read the enabled arcs and their reduced cost.
+    file_.read(reinterpret_cast<char*>(mask_.data()), mask_.size());
+    const auto size = static_cast<Size>(reduced_cost.size());
+    const auto data = reduced_cost.data();
+    for (Size idx = 0; idx < size; ++idx)
+    {
+        data[idx] = nan;
+        if (get_bitset(mask_.data(), idx))
+        {
+            file_.read(reinterpret_cast<char*>(&data[idx]), sizeof(Cost));
+        }
+    }
+    release_assert(file_.good(), "Pricing capture file is truncated");
+    return true;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "labeling/labeling_algorithm.h"
+#include "problem/instance.h"
+#include "types/basic_types.h"
+#include "types/matrix.h"
+#include "types/string.h"
+#include "types/vector.h"
+#include <fstream>
+
+// Binary file of the inputs of a sequence of pricing problems, for replaying the labeling algorithms outside of the
+// solver. The file starts with a header holding the number of vertices of the instance. Each pricing problem stores
+// the feasible master flag, the budget, a bitmask of the enabled arcs, which excludes the arcs disabled by the
+// instance and by branching, and the reduced cost of every enabled arc in row-major order.
+class PricingCaptureWriter
+{
+    String path_;
+    std::ofstream file_;
+    Vector<Byte> mask_;
+    Size num_calls_;
+
+  public:
+    // Constructors and destructor
+    PricingCaptureWriter(const String& path, const Instance& instance);
+    PricingCaptureWriter() = delete;
+    PricingCaptureWriter(const PricingCaptureWriter&) = delete;
+    PricingCaptureWriter(PricingCaptureWriter&&) = delete;
+    PricingCaptureWriter& operator=(const PricingCaptureWriter&) = delete;
+    PricingCaptureWriter& operator=(PricingCaptureWriter&&) = delete;
+    ~PricingCaptureWriter();
+
+    // Write the inputs of a pricing problem
+    void write(const Matrix<Cost>& reduced_cost, const Bool feasible_master, const LabelingBudget& budget);
+
+    // Getters
+    inline auto num_calls() const { return num_calls_; }
+};
+
+class PricingCaptureReader
+{
+    std::ifstream file_;
+    Vector<Byte> mask_;
+
+  public:
+    // Constructors and destructor
+    PricingCaptureReader(const String& path, const Instance& instance);
+    PricingCaptureReader() = delete;
+    PricingCaptureReader(const PricingCaptureReader&) = delete;
+    PricingCaptureReader(PricingCaptureReader&&) = delete;
+    PricingCaptureReader& operator=(const PricingCaptureReader&) = delete;
+    PricingCaptureReader& operator=(PricingCaptureReader&&) = delete;
+    ~PricingCaptureReader() = default;
+
+    // Read the inputs of the next pricing problem, returning false at the end of the file
+    Bool read(Matrix<Cost>& reduced_cost, Bool& feasible_master, LabelingBudget& budget);
+};
@@ -0,0 +1,363 @@
+// #define PRINT_DEBUG
+
+#include "labeling/q_route_relaxation.h"
+#include "output/formatting.h"
+#include "types/float_compare.h"
+#include <algorithm>
+#include <cmath>
+
+QRouteRelaxation::QRouteRelaxation(const Instance& instance) :
+    instance_(instance),
+    enabled_(true),
+    offsets_(instance.num_customers() + 1),
+    best_cost_(),
+    best_next_(),
+    second_cost_(),
+    second_next_(),
+    forward_best_cost_(),
+    forward_best_prev_(),
+    forward_second_cost_(),
+    forward_second_prev_(),
+    obj_(0),
+    solved_(false),
+    best_path_()
+{
+    // Get instance.
+    const auto num_customers = instance.num_customers();
+
+    // Index the states.
+    Size num_states = 0;
+    for (Vertex j = 0; j < num_customers; ++j)
+    {
+        offsets_[j] = num_states;
+        num_states += std::max(instance.vertex_latest[j] - instance.vertex_earliest[j] + 1, 0);
+    }
+    offsets_[num_customers] = num_states;
+    best_cost_.resize(num_states);
+    best_next_.resize(num_states);
+    second_cost_.resize(num_states);
+    second_next_.resize(num_states);
+
+    // The dynamic program processes the states in decreasing order of time, which requires time to strictly
+    // increase along every arc between customers.
+    for (Vertex i = 0; i < num_customers; ++i)
+        for (Vertex j = 0; j < num_customers; ++j)
+            if (i != j && instance.is_valid(i, j) && instance.service_plus_travel(i, j) <= 0)
+            {
+                enabled_ = false;
+            }
+    debugln("Q-route relaxation has {} states{}", num_states, enabled_ ? "" : " and is disabled");
+}
+
+void QRouteRelaxation::solve(
+    const Matrix<Cost>& reduced_cost,          // Reduced cost of every arc, NaN if disabled
+    const LabelingPathFunction& add_path       // Receives the elementary paths with negative reduced cost
+)
+{
+    // Get infinity value.
+    constexpr auto inf = std::numeric_limits<Cost>::infinity();
+
+    // Skip if the relaxation cannot be solved.
+    solved_ = false;
+    obj_ = 0;
+    best_path_.clear();
+    if (!enabled_)
+    {
+        return;
+    }
+
+    // Get instance.
+    const auto num_customers = instance_.num_customers();
+    const auto depot = instance_.depot();
+    const auto& vertex_earliest = instance_.vertex_earliest;
+    const auto& vertex_latest = instance_.vertex_latest;
+    const auto& service_plus_travel = instance_.service_plus_travel;
+    const auto depot_latest = vertex_latest[depot];
+
+    // Compute the two cheapest completions with different successors at every state, starting from the latest time.
+    // The completion of a path that arrives from customer i uses the second cheapest completion if the cheapest one
+    // immediately returns to i.
+    Time max_time = 0;
+    for (Vertex j = 0; j < num_customers; ++j)
+    {
+        max_time = std::max(max_time, vertex_latest[j]);
+    }
+    for (Int32 t = max_time; t >= 0; --t)
+        for (Vertex j = 0; j < num_customers; ++j)
+            if (vertex_earliest[j] <= t && t <= vertex_latest[j])
+            {
+                Cost best_cost = inf;
+                Vertex best_next = -1;
+                Cost second_cost = inf;
+                Vertex second_next = -1;
+                const auto update = [&](const Cost cost, const Vertex next)
+                {
+                    if (cost < best_cost)
+                    {
+                        second_cost = best_cost;
+                        second_next = best_next;
+                        best_cost = cost;
+                        best_next = next;
+                    }
+                    else if (cost < second_cost)
+                    {
+                        second_cost = cost;
+                        second_next = next;
+                    }
+                };
+
+                // Return to the depot.
+                if (!std::isnan(reduced_cost(j, depot)) && t + service_plus_travel(j, depot) <= depot_latest)
+                {
+                    update(reduced_cost(j, depot), depot);
+                }
+
+                // Extend to another customer.
+                for (Vertex k = 0; k < num_customers; ++k)
+                    if (k != j && !std::isnan(reduced_cost(j, k)))
+                    {
+                        const Int32 t_k = std::max<Int32>(vertex_earliest[k], t + service_plus_travel(j, k));
+                        if (t_k <= vertex_latest[k])
+                        {
+                            debug_assert(t_k > t);
+                            const auto [cost_k, _] = completion(offsets_[k] + (t_k - vertex_earliest[k]), j);
+                            update(reduced_cost(j, k) + cost_k, k);
+                        }
+                    }
+
+                // Store.
+                const auto state = offsets_[j] + (t - vertex_earliest[j]);
+                best_cost_[state] = best_cost;
+                best_next_[state] = best_next;
+                second_cost_[state] = second_cost;
+                second_next_[state] = second_next;
+            }
+    solved_ = true;
+
+    // Find the cheapest path starting at each customer. Output the ones that are elementary and satisfy the vehicle
+    // capacity since the relaxation does not enforce these.
+    Vector<Byte> visited(num_customers);
+    Vector<Vertex> path;
+    for (Vertex j = 0; j < num_customers; ++j)
+        if (!std::isnan(reduced_cost(depot, j)))
+        {
+            // Get the start time.
+            const Int32 t_j = std::max<Int32>(vertex_earliest[j],
+                                              vertex_earliest[depot] + service_plus_travel(depot, j));
+            if (t_j > vertex_latest[j])
+            {
+                continue;
+            }
+
+            // Compute the reduced cost.
+            const auto state = offsets_[j] + (t_j - vertex_earliest[j]);
+            const auto path_reduced_cost = reduced_cost(depot, j) + best_cost_[state];
+            const auto is_best = path_reduced_cost < obj_;
+            obj_ = std::min(obj_, path_reduced_cost);
+            if (!is_lt(path_reduced_cost, 0.0))
+            {
+                continue;
+            }
+
+            // Get the path.
+            path.clear();
+            path.push_back(depot);
+            std::fill(visited.begin(), visited.end(), false);
+            Bool feasible = true;
+            Int32 load = 0;
+            {
+                Vertex prev = depot;
+                Vertex i = j;
+                Int32 t = t_j;
+                while (i != depot)
+                {
+                    // Check elementarity and capacity.
+                    feasible &= !visited[i];
+                    visited[i] = true;
+                    load += instance_.vertex_load[i];
+                    path.push_back(i);
+
+                    // Move to the next vertex. The first customer has no previous customer to avoid.
+                    const auto state = offsets_[i] + (t - vertex_earliest[i]);
+                    const auto next = prev == depot ? best_next_[state] : completion(state, prev).second;
+                    debug_assert(next >= 0);
+                    if (next != depot)
+                    {
+                        t = std::max<Int32>(vertex_earliest[next], t + service_plus_travel(i, next));
+                    }
+                    prev = i;
+                    i = next;
+                }
+            }
+            path.push_back(depot);
+            feasible &= load <= instance_.vehicle_load_capacity;
+            if (is_best)
+            {
+                best_path_ = path;
+            }
+
+            // Output the path.
+            if (feasible)
+            {
+#ifdef DEBUG
+                {
+                    Cost check_reduced_cost = 0;
+                    for (Size idx = 0; idx < static_cast<Size>(path.size()) - 1; ++idx)
+                    {
+                        check_reduced_cost += reduced_cost(path[idx], path[idx + 1]);
+                    }
+                    debug_assert(is_eq(check_reduced_cost, path_reduced_cost));
+                }
+#endif
+                debugln("    Q-route relaxation found path with reduced cost {}: {}",
+                        path_reduced_cost, format_path(path));
+                add_path(Vector<Vertex>(path), path_reduced_cost);
+            }
+        }
+    debugln("    Q-route relaxation has minimum reduced cost {}", obj_);
+}
+
+void QRouteRelaxation::calculate_arc_bounds(
+    const Matrix<Cost>& reduced_cost,    // Reduced cost of every arc, NaN if disabled
+    Matrix<Cost>& arc_bounds             // Lower bound on the reduced cost of every path using each arc
+)
+{
+    // Get infinity value.
+    constexpr auto inf = std::numeric_limits<Cost>::infinity();
+
+    // Check.
+    debug_assert(solved_);
+    debug_assert(arc_bounds.rows() == reduced_cost.rows() && arc_bounds.cols() == reduced_cost.cols());
+
+    // Get instance.
+    const auto num_customers = instance_.num_customers();
+    const auto depot = instance_.depot();
+    const auto& vertex_earliest = instance_.vertex_earliest;
+    const auto& vertex_latest = instance_.vertex_latest;
+    const auto& service_plus_travel = instance_.service_plus_travel;
+    const auto depot_earliest = vertex_earliest[depot];
+    const auto depot_latest = vertex_latest[depot];
+
+    // Allocate the forward states.
+    const auto num_states = offsets_[num_customers];
+    forward_best_cost_.resize(num_states);
+    forward_best_prev_.resize(num_states);
+    forward_second_cost_.resize(num_states);
+    forward_second_prev_.resize(num_states);
+    std::fill(forward_best_cost_.begin(), forward_best_cost_.end(), inf);
+    std::fill(forward_best_prev_.begin(), forward_best_prev_.end(), -1);
+    std::fill(forward_second_cost_.begin(), forward_second_cost_.end(), inf);
+    std::fill(forward_second_prev_.begin(), forward_second_prev_.end(), -1);
+
+    // Store a path into a state, keeping the two cheapest paths with different previous customers. A state can be
+    // reached from the same previous customer at different times because of waiting.
+    const auto update = [&](const Size state, const Cost cost, const Vertex prev)
+    {
+        auto& best_cost = forward_best_cost_[state];
+        auto& best_prev = forward_best_prev_[state];
+        auto& second_cost = forward_second_cost_[state];
+        auto& second_prev = forward_second_prev_[state];
+        if (cost < best_cost)
+        {
+            if (prev != best_prev)
+            {
+                second_cost = best_cost;
+                second_prev = best_prev;
+            }
+            best_cost = cost;
+            best_prev = prev;
+        }
+        else if (prev != best_prev && cost < second_cost)
+        {
+            second_cost = cost;
+            second_prev = prev;
+        }
+    };
+
+    // Leave the depot.
+    for (Vertex j = 0; j < num_customers; ++j)
+        if (!std::isnan(reduced_cost(depot, j)))
+        {
+            const Int32 t_j = std::max<Int32>(vertex_earliest[j], depot_earliest + service_plus_travel(depot, j));
+            if (t_j <= vertex_latest[j])
+            {
+                update(offsets_[j] + (t_j - vertex_earliest[j]), reduced_cost(depot, j), depot);
+            }
+        }
+
+    // Extend the cheapest paths in increasing order of time. A path does not immediately return to the customer it
+    // came from.
+    Time max_time = 0;
+    for (Vertex j = 0; j < num_customers; ++j)
+    {
+        max_time = std::max(max_time, vertex_latest[j]);
+    }
+    for (Int32 t = 0; t <= max_time; ++t)
+        for (Vertex j = 0; j < num_customers; ++j)
+            if (vertex_earliest[j] <= t && t <= vertex_latest[j])
+            {
+                const auto state = offsets_[j] + (t - vertex_earliest[j]);
+                if (forward_best_cost_[state] == inf)
+                {
+                    continue;
+                }
+                for (Vertex k = 0; k < num_customers; ++k)
+                    if (k != j && !std::isnan(reduced_cost(j, k)))
+                    {
+                        const Int32 t_k = std::max<Int32>(vertex_earliest[k], t + service_plus_travel(j, k));
+                        if (t_k <= vertex_latest[k])
+                        {
+                            debug_assert(t_k > t);
+                            const auto cost = forward_completion(state, k);
+                            if (cost < inf)
+                            {
+                                update(offsets_[k] + (t_k - vertex_earliest[k]), cost + reduced_cost(j, k), j);
+                            }
+                        }
+                    }
+            }
+
+    // Bound the arcs leaving the depot by the cheapest completion from the first customer.
+    arc_bounds.set(inf);
+    for (Vertex j = 0; j < num_customers; ++j)
+        if (!std::isnan(reduced_cost(depot, j)))
+        {
+            const Int32 t_j = std::max<Int32>(vertex_earliest[j], depot_earliest + service_plus_travel(depot, j));
+            if (t_j <= vertex_latest[j])
+            {
+                arc_bounds(depot, j) = reduced_cost(depot, j) + best_cost_[offsets_[j] + (t_j - vertex_earliest[j])];
+            }
+        }
+
+    // Bound the arcs leaving each customer by joining the cheapest path into the customer with the cheapest
+    // completion from the next customer at every time.
+    for (Vertex i = 0; i < num_customers; ++i)
+        for (Int32 t = vertex_earliest[i]; t <= vertex_latest[i]; ++t)
+        {
+            const auto state = offsets_[i] + (t - vertex_earliest[i]);
+            if (forward_best_cost_[state] == inf)
+            {
+                continue;
+            }
+
+            // Return to the depot.
+            if (!std::isnan(reduced_cost(i, depot)) && t + service_plus_travel(i, depot) <= depot_latest)
+            {
+                const auto bound = forward_best_cost_[state] + reduced_cost(i, depot);
+                arc_bounds(i, depot) = std::min(arc_bounds(i, depot), bound);
+            }
+
+            // Extend to another customer.
+            for (Vertex j = 0; j < num_customers; ++j)
+                if (j != i && !std::isnan(reduced_cost(i, j)))
+                {
+                    const Int32 t_j = std::max<Int32>(vertex_earliest[j], t + service_plus_travel(i, j));
+                    if (t_j <= vertex_latest[j])
+                    {
+                        const auto [cost_j, _] = completion(offsets_[j] + (t_j - vertex_earliest[j]), i);
+                        const auto bound = forward_completion(state, j) + reduced_cost(i, j) + cost_j;
+                        arc_bounds(i, j) = std::min(arc_bounds(i, j), bound);
+                    }
+                }
+        }
+}
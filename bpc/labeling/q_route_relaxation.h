@@ -0,0 +1,90 @@
+#pragma once
+
+#include "labeling/labeling_algorithm.h"
+#include "problem/debug.h"
+#include "problem/instance.h"
+#include "types/basic_types.h"
+#include "types/matrix.h"
+#include "types/tuple.h"
+#include "types/vector.h"
+#include <limits>
+
+// Relaxation of the pricing problem over (vertex, time) states that allows paths to revisit customers, except
+// immediately after leaving them. It is solved by a backward dynamic program whose value at each state is the
+// reduced cost of the cheapest completion to the depot. This gives a lower bound on the reduced cost of every path,
+// completion bounds for pruning labels in the labeling algorithms, and paths that are elementary by chance. A forward
+// dynamic program over the same states combines with the completions to bound the reduced cost of every path using
+// each arc.
+class QRouteRelaxation
+{
+    // Instance
+    const Instance& instance_;
+    Bool enabled_;
+
+    // States of each customer j at the times between its earliest and latest time
+    Vector<Size> offsets_;
+    Vector<Cost> best_cost_;
+    Vector<Vertex> best_next_;
+    Vector<Cost> second_cost_;
+    Vector<Vertex> second_next_;
+
+    // Cheapest paths from the depot to the states of each customer, allocated on first use
+    Vector<Cost> forward_best_cost_;
+    Vector<Vertex> forward_best_prev_;
+    Vector<Cost> forward_second_cost_;
+    Vector<Vertex> forward_second_prev_;
+
+    // Output of the last call
+    Cost obj_;
+    Bool solved_;
+    Vector<Vertex> best_path_;
+
+  public:
+    // Constructors and destructor
+    QRouteRelaxation(const Instance& instance);
+    QRouteRelaxation() = delete;
+    QRouteRelaxation(const QRouteRelaxation&) = delete;
+    QRouteRelaxation(QRouteRelaxation&&) = delete;
+    QRouteRelaxation& operator=(const QRouteRelaxation&) = delete;
+    QRouteRelaxation& operator=(QRouteRelaxation&&) = delete;
+    ~QRouteRelaxation() = default;
+
+    // Solve
+    void solve(const Matrix<Cost>& reduced_cost, const LabelingPathFunction& add_path);
+
+    // Compute a lower bound on the reduced cost of every path using each arc from the completions of the last call to
+    // solve, which must have used the same reduced costs. Arcs that no path can use get an infinite bound.
+    void calculate_arc_bounds(const Matrix<Cost>& reduced_cost, Matrix<Cost>& arc_bounds);
+
+    // Getters
+    inline auto enabled() const { return enabled_; }
+    inline auto solved() const { return solved_; }
+    inline auto obj() const { return obj_; }
+    inline const auto& best_path() const { return best_path_; }
+
+    // Get a lower bound on the reduced cost of any path from customer j starting at time t to the depot
+    inline Cost completion_bound(const Vertex j, const Time t) const
+    {
+        if (!solved_)
+        {
+            return -std::numeric_limits<Cost>::infinity();
+        }
+        debug_assert(j < instance_.num_customers());
+        debug_assert(instance_.vertex_earliest[j] <= t && t <= instance_.vertex_latest[j]);
+        return best_cost_[offsets_[j] + (t - instance_.vertex_earliest[j])];
+    }
+
+  private:
+    // Get the cost of the cheapest completion from a state that does not return to the previous customer
+    inline Pair<Cost, Vertex> completion(const Size state, const Vertex prev) const
+    {
+        return best_next_[state] != prev ? Pair<Cost, Vertex>{best_cost_[state], best_next_[state]} :
+                                           Pair<Cost, Vertex>{second_cost_[state], second_next_[state]};
+    }
+
+    // Get the cost of the cheapest path from the depot to a state that does not come from the next customer
+    inline Cost forward_completion(const Size state, const Vertex next) const
+    {
+        return forward_best_prev_[state] != next ? forward_best_cost_[state] : forward_second_cost_[state];
+    }
+};
@@ -24,6 +24,7 @@ SCIP_Retcode start_solver(
     SCIP_Real time_limit = 0;
     SCIP_Longint node_limit = 0;
     SCIP_Real gap_limit = 0;
+    String capture_path;
     try
     {
         // Create program options.
@@ -36,6 +37,7 @@ SCIP_Retcode start_solver(
             ("t,time-limit", "Time limit in seconds", cxxopts::value<SCIP_Real>())
             ("n,node-limit", "Maximum number of branch-and-bound nodes", cxxopts::value<SCIP_Longint>())
             ("g,gap-limit", "Solve to an optimality gap", cxxopts::value<SCIP_Real>())
+            ("capture-pricing", "Write the inputs of every pricing problem to a file", cxxopts::value<String>())
         ;
         options.parse_positional({"instance"});
 
@@ -69,6 +71,12 @@ SCIP_Retcode start_solver(
         {
             gap_limit = result["gap-limit"].as<SCIP_Real>();
         }
+
+        // Get path to the pricing capture file.
+        if (result.count("capture-pricing"))
+        {
+            capture_path = result["capture-pricing"].as<String>();
+        }
     }
     catch (const cxxopts::exceptions::exception& e)
     {
@@ -260,12 +268,19 @@ SCIP_Retcode start_solver(
     // Create problem.
     Problem::create(scip, instance);
 
+    // Capture the pricing problems.
+    if (!capture_path.empty())
+    {
+        SCIP_CALL(SCIPsetStringParam(scip, "pricers/labeling/capturefile", capture_path.c_str()));
+    }
+
     // Solve.
     SCIP_CALL(SCIPsolve(scip));
 
     // Print statistics.
     println("");
     SCIP_CALL(SCIPprintStatistics(scip, nullptr));
+    print_path_statistics(scip);
 
     // Print best solution.
     print_best_solution(scip);
@@ -1,13 +1,12 @@
 #include "output/formatting.h"
 #include "problem/debug.h"
-#include "problem/problem.h"
 #include "types/bitset.h"
 #include <fmt/ranges.h>
 
 // Make a string of the vertex number in a path
 String format_path(
-    const Vector<Vertex>& path,   // Path
-    const String& separator       // Separator
+    const Span<const Vertex> path,    // Path
+    const String& separator           // Separator
 )
 {
     return fmt::format("({})", fmt::join(path, separator));
@@ -15,7 +14,7 @@ String format_path(
 
 // Make a string of the names of the vertices in a path
 String format_path_with_names(
-    const Vector<Vertex>& path,           // Path
+    const Span<const Vertex> path,        // Path
     const Vector<String>& vertex_name,    // Names of the vertices
     const String& separator                // Separator
 )
@@ -1,19 +1,19 @@
 #pragma once
 
-#include "problem/scip.h"
 #include "types/basic_types.h"
+#include "types/span.h"
 #include "types/string.h"
 #include "types/vector.h"
 
 // Make a string of the vertex number in a path
 String format_path(
-    const Vector<Vertex>& path,       // Path
+    const Span<const Vertex> path,    // Path
     const String& separator = ", "    // Separator
 );
 
 // Make a string of the names of the vertices in a path
 String format_path_with_names(
-    const Vector<Vertex>& path,           // Path
+    const Span<const Vertex> path,        // Path
     const Vector<String>& vertex_name,    // Names of the vertices
     const String& separator = ", "        // Separator
 );
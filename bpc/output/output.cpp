@@ -5,6 +5,7 @@
 #include "problem/debug.h"
 #include "problem/problem.h"
 #include "problem/scip.h"
+#include <algorithm>
 #include <fmt/color.h>
 
 // Print paths with positive value
@@ -18,42 +19,32 @@ void print_positive_paths(
     const auto& vars = problem.vars;
     const auto& instance = *problem.instance;
     const auto num_customers = instance.num_customers();
+    const auto num_vertices = instance.num_vertices();
 
-    // Get fractional edges and determine if the solution is fractional.
+    // Get fractional edges and determine if the solution is fractional. The edges of the LP solution are the ones
+    // used for branching.
+    if (!sol)
+    {
+        problem.update_variable_values(scip);
+    }
+    FractionalEdges sol_fractional_edges(sol ? num_vertices : 0);
     Bool is_fractional = false;
-    HashMap<Edge, SCIP_Real> fractional_edges;
-    for (const auto& [var, _, path] : vars)
+    for (Size v = 0; v < vars.size(); ++v)
     {
         // Get the variable value.
-        const auto val = SCIPgetSolVal(scip, sol, var);
+        const auto val = sol ? SCIPgetSolVal(scip, sol, vars.var(v)) : vars.val(v);
 
-        // Store the vertices and edges of the path.
-        if (SCIPisPositive(scip, val) && !SCIPisIntegral(scip, val))
+        // Store the edges of the path.
+        if (sol && SCIPisPositive(scip, val) && !SCIPisIntegral(scip, val))
         {
-            for (Size idx = 0; idx < path.size() - 1; ++idx)
-            {
-                const Edge edge{path[idx], path[idx + 1]};
-                fractional_edges[edge] += val;
-            }
+            sol_fractional_edges.add(vars.path(v), val);
         }
 
         // Store fractional status.
         is_fractional |= !SCIPisIntegral(scip, val);
     }
-
-    // Delete edges with integer values.
-    for (auto it = fractional_edges.begin(); it != fractional_edges.end();)
-    {
-        const auto& [edge, val] = *it;
-        if (SCIPisIntegral(scip, val))
-        {
-            it = fractional_edges.erase(it);
-        }
-        else
-        {
-            ++it;
-        }
-    }
+    sol_fractional_edges.finish(scip);
+    const auto& fractional_edges = sol ? sol_fractional_edges : problem.fractional_edges;
 
     // Print header.
     if (sol)
@@ -110,7 +101,7 @@ void print_positive_paths(
                 const auto j = path[idx + 1];
 
                 const Edge edge{i, j};
-                const auto edge_is_fractional = (fractional_edges.find(edge) != fractional_edges.end());
+                const auto edge_is_fractional = fractional_edges.contains(edge);
 
                 const auto str = fmt::format("{} ({})", i, instance.vertex_name[i]);
                 if (edge_is_fractional || prev_edge_is_fractional)
@@ -187,12 +178,21 @@ void print_best_solution(SCIP* scip)
     }
 }
 
+// Print statistics of the path variables
+void print_path_statistics(SCIP* scip)
+{
+    const auto& problem = *reinterpret_cast<Problem*>(SCIPgetProbData(scip));
+    println("Path variables     :");
+    println("  Added            : {:>10d}", problem.vars.size());
+    println("  Duplicates       : {:>10d}", problem.num_duplicate_paths);
+    println("  Deleted          : {:>10d}", problem.num_deleted_vars);
+}
+
 // Print solution
 void print_solution(SCIP* scip, SCIP_Sol* sol)
 {
     // Get problem.
     auto& problem = *reinterpret_cast<Problem*>(SCIPgetProbData(scip));
-    const auto& vars = problem.vars;
     const auto& instance = *problem.instance;
     const auto& depot = instance.depot();
     const auto& vertex_name = instance.vertex_name;
@@ -201,32 +201,43 @@ void print_solution(SCIP* scip, SCIP_Sol* sol)
     const auto& cost = instance.cost;
     const auto& service_plus_travel = instance.service_plus_travel;
 
-    // Print solution.
-    println("Objective value: {}", SCIPgetSolOrigObj(scip, sol));
+    // Get the paths.
+    const auto paths = problem.get_solution_paths(scip, sol);
+    Cost obj = 0;
+    for (const auto& path : paths)
+        for (Size idx = 0; idx < static_cast<Size>(path.size()) - 1; ++idx)
+        {
+            obj += cost(path[idx], path[idx + 1]);
+        }
+    debug_assert(SCIPisLE(scip, obj, SCIPgetSolOrigObj(scip, sol)));
+
+    // Print solution. The solution can still cover customers more than once if it was found after the last repair, in
+    // which case its objective value differs from the primal bound.
+    if (SCIPisLT(scip, obj, SCIPgetSolOrigObj(scip, sol)))
+    {
+        println("Removed the extra visits of the solution with objective value {}", SCIPgetSolOrigObj(scip, sol));
+    }
+    println("Objective value: {}", obj);
     println("-----------------------------------------------------------------");
     println("{:>13s}{:>13s}{:>13s}{:>13s}{:>13s}", "Vehicle", "Vertex", "Cost", "Load", "Time");
     println("-----------------------------------------------------------------");
     Size vehicle = 0;
-    for (const auto& [var, _, path] : vars)
+    for (const auto& path : paths)
     {
-        const auto val = SCIPgetSolVal(scip, sol, var);
-        if (SCIPisEQ(scip, val, 1.0))
+        Vertex h = depot;
+        Cost route_cost = 0;
+        Load route_load = 0;
+        Time route_time = 0;
+        for (Size idx = 0; idx < static_cast<Size>(path.size()); ++idx)
         {
-            Vertex h = depot;
-            Cost route_cost = 0;
-            Load route_load = 0;
-            Time route_time = 0;
-            for (Size idx = 0; idx < path.size(); ++idx)
-            {
-                const auto i = path[idx];
-                route_cost = route_cost + (idx != 0 ? cost(h, i) : 0);
-                route_load += vertex_load[i];
-                route_time = std::max<Time>(route_time + service_plus_travel(h, i), vertex_earliest[i]);
-                println("{:>13d}{:>13s}{:>13.2f}{:>13d}{:>13d}", vehicle, vertex_name[i], route_cost, route_load, route_time);
-                h = i;
-            }
-            println("-----------------------------------------------------------------");
-            ++vehicle;
+            const auto i = path[idx];
+            route_cost = route_cost + (idx != 0 ? cost(h, i) : 0);
+            route_load += vertex_load[i];
+            route_time = std::max<Time>(route_time + service_plus_travel(h, i), vertex_earliest[i]);
+            println("{:>13d}{:>13s}{:>13.2f}{:>13d}{:>13d}", vehicle, vertex_name[i], route_cost, route_load, route_time);
+            h = i;
         }
+        println("-----------------------------------------------------------------");
+        ++vehicle;
     }
 }
@@ -11,5 +11,8 @@ void print_positive_paths(
 // Print best solution
 void print_best_solution(SCIP* scip);
 
+// Print statistics of the path variables
+void print_path_statistics(SCIP* scip);
+
 // // Print solution
 void print_solution(SCIP* scip, SCIP_Sol* sol);
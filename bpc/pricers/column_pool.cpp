@@ -0,0 +1,249 @@
+// #define PRINT_DEBUG
+
+#include "pricers/column_pool.h"
+#include "problem/debug.h"
+#include "types/float_compare.h"
+#include "types/tuple.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifndef COLUMN_POOL_MAX_SIZE
+#define COLUMN_POOL_MAX_SIZE (50000)    // Maximum number of paths in the pool
+#endif
+#ifndef COLUMN_POOL_EVICT_FRACTION
+#define COLUMN_POOL_EVICT_FRACTION (0.2)   // Fraction of the paths evicted when the pool is full
+#endif
+
+ColumnPool::ColumnPool(const Instance& instance) :
+    instance_(instance),
+    customers_(),
+    offsets_(1, 0),
+    costs_(),
+    hashes_(),
+    last_negative_(),
+    index_(),
+    num_removed_(0),
+    num_reprices_(0),
+    reduced_costs_()
+{
+}
+
+UInt64 ColumnPool::hash(const Vertex* const customers, const Size num_customers)
+{
+    return ankerl::unordered_dense::detail::wyhash::hash(customers, num_customers * sizeof(Vertex));
+}
+
+Size ColumnPool::find(const Vertex* const customers, const Size num_customers, const UInt64 hash) const
+{
+    if (const auto it = index_.find(hash); it != index_.end())
+    {
+        const auto idx = it->second;
+        const auto begin = customers_.data() + offsets_[idx];
+        const auto end = customers_.data() + offsets_[idx + 1];
+        if (end - begin == num_customers && std::equal(begin, end, customers))
+        {
+            return idx;
+        }
+    }
+    return -1;
+}
+
+void ColumnPool::add(const Span<const Vertex> path)
+{
+    // Check.
+    debug_assert(path.size() >= 3);
+    debug_assert(path.front() == instance_.depot());
+    debug_assert(path.back() == instance_.depot());
+
+    // Skip if the path is already in the pool. Paths whose hash collides with a different path are also skipped.
+    const auto path_customers = path.data() + 1;
+    const auto num_path_customers = static_cast<Size>(path.size()) - 2;
+    const auto path_hash = hash(path_customers, num_path_customers);
+    if (index_.find(path_hash) != index_.end())
+    {
+        return;
+    }
+
+    // Make space if the pool is full.
+    if (size() >= COLUMN_POOL_MAX_SIZE)
+    {
+        evict();
+    }
+
+    // Calculate the cost.
+    Cost cost = 0;
+    for (Size idx = 0; idx < static_cast<Size>(path.size()) - 1; ++idx)
+    {
+        cost += instance_.cost(path[idx], path[idx + 1]);
+    }
+
+    // Store the path.
+    index_.emplace(path_hash, static_cast<Size>(costs_.size()));
+    customers_.insert(customers_.end(), path_customers, path_customers + num_path_customers);
+    offsets_.push_back(customers_.size());
+    costs_.push_back(cost);
+    hashes_.push_back(path_hash);
+    last_negative_.push_back(num_reprices_);
+}
+
+void ColumnPool::remove(const Vector<Vertex>& path)
+{
+    // Check.
+    debug_assert(path.size() >= 3);
+
+    // Find the path.
+    const auto path_customers = path.data() + 1;
+    const auto num_path_customers = static_cast<Size>(path.size()) - 2;
+    const auto path_hash = hash(path_customers, num_path_customers);
+    const auto idx = find(path_customers, num_path_customers, path_hash);
+
+    // Mark the path as removed.
+    if (idx >= 0)
+    {
+        costs_[idx] = std::numeric_limits<Cost>::quiet_NaN();
+        index_.erase(path_hash);
+        ++num_removed_;
+    }
+}
+
+void ColumnPool::compact()
+{
+    // Move the remaining paths to the front.
+    Size new_num_paths = 0;
+    Size new_num_customers = 0;
+    index_.clear();
+    for (Size idx = 0; idx < static_cast<Size>(costs_.size()); ++idx)
+        if (!std::isnan(costs_[idx]))
+        {
+            const auto begin = offsets_[idx];
+            const auto end = offsets_[idx + 1];
+            std::copy(customers_.begin() + begin, customers_.begin() + end, customers_.begin() + new_num_customers);
+
+            offsets_[new_num_paths] = new_num_customers;
+            costs_[new_num_paths] = costs_[idx];
+            hashes_[new_num_paths] = hashes_[idx];
+            last_negative_[new_num_paths] = last_negative_[idx];
+            index_.emplace(hashes_[idx], new_num_paths);
+
+            new_num_customers += end - begin;
+            ++new_num_paths;
+        }
+    customers_.resize(new_num_customers);
+    offsets_.resize(new_num_paths + 1);
+    offsets_[new_num_paths] = new_num_customers;
+    costs_.resize(new_num_paths);
+    hashes_.resize(new_num_paths);
+    last_negative_.resize(new_num_paths);
+    num_removed_ = 0;
+}
+
+void ColumnPool::evict()
+{
+    // Find the paths whose reduced cost was negative least recently.
+    Vector<Pair<Size, Size>> candidates;
+    candidates.reserve(size());
+    for (Size idx = 0; idx < static_cast<Size>(costs_.size()); ++idx)
+        if (!std::isnan(costs_[idx]))
+        {
+            candidates.push_back({last_negative_[idx], idx});
+        }
+    const auto num_evicted = std::min<Size>(std::max<Size>(COLUMN_POOL_EVICT_FRACTION * candidates.size(), 1),
+                                            candidates.size());
+    std::nth_element(candidates.begin(), candidates.begin() + (num_evicted - 1), candidates.end());
+
+    // Remove the paths.
+    for (Size k = 0; k < num_evicted; ++k)
+    {
+        const auto idx = candidates[k].second;
+        costs_[idx] = std::numeric_limits<Cost>::quiet_NaN();
+        index_.erase(hashes_[idx]);
+        ++num_removed_;
+    }
+    debugln("    Column pool evicted {} paths", num_evicted);
+    compact();
+}
+
+void ColumnPool::reprice(
+    const Bool feasible_master,           // Indicates if the master problem is feasible
+    const Vector<Cost>& duals,            // Dual value of each customer cover constraint
+    const Matrix<Cost>& reduced_cost,     // Reduced cost of every arc, NaN if disabled in the current node
+    const Size max_paths,                 // Maximum number of paths to output
+    Vector<PricedPath>& paths             // Output paths
+)
+{
+    // Check.
+    debug_assert(static_cast<Size>(duals.size()) == instance_.num_customers());
+
+    // Get instance.
+    const auto depot = instance_.depot();
+
+    // Compute the reduced cost of every path without the branching decisions. Removed paths have NaN cost.
+    const auto num_paths = static_cast<Size>(costs_.size());
+    reduced_costs_.resize(num_paths);
+    {
+        const auto customers = customers_.data();
+        const auto offsets = offsets_.data();
+        const auto dual = duals.data();
+        const Cost cost_scale = feasible_master;
+        for (Size idx = 0; idx < num_paths; ++idx)
+        {
+            Cost sum = 0;
+            for (Size k = offsets[idx]; k < offsets[idx + 1]; ++k)
+            {
+                sum += dual[customers[k]];
+            }
+            reduced_costs_[idx] = cost_scale * costs_[idx] - sum;
+        }
+    }
+
+    // Find the paths with negative reduced cost that are not disabled in the current node.
+    ++num_reprices_;
+    Vector<Pair<Cost, Size>> candidates;
+    for (Size idx = 0; idx < num_paths; ++idx)
+        if (is_lt(reduced_costs_[idx], 0.0))
+        {
+            last_negative_[idx] = num_reprices_;
+            const auto begin = offsets_[idx];
+            const auto end = offsets_[idx + 1];
+            Bool valid = !std::isnan(reduced_cost(depot, customers_[begin])) &&
+                         !std::isnan(reduced_cost(customers_[end - 1], depot));
+            for (Size k = begin; valid && k < end - 1; ++k)
+            {
+                valid = !std::isnan(reduced_cost(customers_[k], customers_[k + 1]));
+            }
+            if (valid)
+            {
+                candidates.push_back({reduced_costs_[idx], idx});
+            }
+        }
+
+    // Keep the most negative paths.
+    if (static_cast<Size>(candidates.size()) > max_paths)
+    {
+        std::nth_element(candidates.begin(), candidates.begin() + max_paths, candidates.end());
+        candidates.resize(max_paths);
+    }
+
+    // Move the paths out of the pool.
+    for (const auto& [path_reduced_cost, idx] : candidates)
+    {
+        auto& [output_reduced_cost, path] = paths.emplace_back();
+        output_reduced_cost = path_reduced_cost;
+        path.reserve(offsets_[idx + 1] - offsets_[idx] + 2);
+        path.push_back(depot);
+        path.insert(path.end(), customers_.begin() + offsets_[idx], customers_.begin() + offsets_[idx + 1]);
+        path.push_back(depot);
+
+        costs_[idx] = std::numeric_limits<Cost>::quiet_NaN();
+        index_.erase(hashes_[idx]);
+        ++num_removed_;
+    }
+    debugln("    Column pool of size {} found {} paths with negative reduced cost", size(), candidates.size());
+
+    // Remove the deleted paths.
+    if (num_removed_ > 0)
+    {
+        compact();
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "pricers/pricing_portfolio.h"
+#include "problem/instance.h"
+#include "types/basic_types.h"
+#include "types/hash_map.h"
+#include "types/matrix.h"
+#include "types/span.h"
+#include "types/vector.h"
+
+// Pool of paths with negative reduced cost that were not added to the master problem. The paths are shared by all
+// nodes of the branch-and-bound tree and are stored as the customers of each path in compressed sparse rows. When the
+// pool is full, the paths whose reduced cost was negative least recently are evicted.
+class ColumnPool
+{
+    // Instance
+    const Instance& instance_;
+
+    // Paths
+    Vector<Vertex> customers_;        // Customers of all paths, excluding the depot
+    Vector<Size> offsets_;            // Index of the first customer of each path, plus the end of the last path
+    Vector<Cost> costs_;              // Cost of each path, NaN if removed
+    Vector<UInt64> hashes_;           // Hash of each path
+    Vector<Size> last_negative_;      // Last call to reprice in which each path had negative reduced cost
+    HashMap<UInt64, Size> index_;     // Index of each path by its hash
+    Size num_removed_;                // Number of removed paths not yet compacted
+    Size num_reprices_;               // Number of calls to reprice
+
+    // Scratch
+    Vector<Cost> reduced_costs_;
+
+  public:
+    // Constructors and destructor
+    ColumnPool(const Instance& instance);
+    ColumnPool() = delete;
+    ColumnPool(const ColumnPool&) = delete;
+    ColumnPool(ColumnPool&&) = delete;
+    ColumnPool& operator=(const ColumnPool&) = delete;
+    ColumnPool& operator=(ColumnPool&&) = delete;
+    ~ColumnPool() = default;
+
+    // Getters
+    inline Size size() const { return static_cast<Size>(costs_.size()) - num_removed_; }
+
+    // Modify
+    void add(const Span<const Vertex> path);
+    void remove(const Vector<Vertex>& path);
+
+    // Move the paths with negative reduced cost out of the pool
+    void reprice(
+        const Bool feasible_master,           // Indicates if the master problem is feasible
+        const Vector<Cost>& duals,            // Dual value of each customer cover constraint
+        const Matrix<Cost>& reduced_cost,     // Reduced cost of every arc, NaN if disabled in the current node
+        const Size max_paths,                 // Maximum number of paths to output
+        Vector<PricedPath>& paths             // Output paths
+    );
+
+  private:
+    // Hash
+    static UInt64 hash(const Vertex* const customers, const Size num_customers);
+    Size find(const Vertex* const customers, const Size num_customers, const UInt64 hash) const;
+
+    // Remove deleted paths from the storage
+    void compact();
+
+    // Remove the paths whose reduced cost was negative least recently
+    void evict();
+};
@@ -0,0 +1,74 @@
+// #define PRINT_DEBUG
+
+#include "pricers/dual_stabilization.h"
+#include "problem/debug.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifndef DUAL_STABILIZATION_ALPHA
+#define DUAL_STABILIZATION_ALPHA (0.8)    // Weight of the stability center in the smoothed duals
+#endif
+
+DualStabilization::DualStabilization(const Size num_customers) :
+    center_(num_customers),
+    center_bound_(-std::numeric_limits<Float>::infinity()),
+    node_(-1),
+    alpha_(DUAL_STABILIZATION_ALPHA),
+    stabilized_duals_(num_customers)
+{
+}
+
+void DualStabilization::start(const Int64 node, const Vector<Cost>& duals, const Vector<Cost>* seed_duals)
+{
+    debug_assert(duals.size() == center_.size());
+    debug_assert(!seed_duals || seed_duals->size() == center_.size());
+
+    // Reset the stability center since the center of another node is not valid. The seed duals, such as the final
+    // duals of the parent node, are close to the optimal duals of the node, so they make a better center than the
+    // first duals of the node.
+    if (node != node_)
+    {
+        node_ = node;
+        center_ = seed_duals ? *seed_duals : duals;
+        center_bound_ = -std::numeric_limits<Float>::infinity();
+        debugln("    Resetting stability center in node {}{}", node, seed_duals ? " to the seed duals" : "");
+    }
+}
+
+Float DualStabilization::alpha(const Size num_mispricings) const
+{
+    // Decrease the weight of the center after each mis-pricing until the duals of the master problem are priced. The
+    // last step is found by counting so that rounding errors do not leave a tiny positive weight.
+    debug_assert(0.0 <= alpha_ && alpha_ < 1.0);
+    const auto num_steps = static_cast<Size>(std::ceil(1.0 / (1.0 - alpha_) - 1e-9));
+    if (num_mispricings + 1 >= num_steps)
+    {
+        return 0.0;
+    }
+    return 1.0 - (num_mispricings + 1) * (1.0 - alpha_);
+}
+
+const Vector<Cost>& DualStabilization::stabilize(const Vector<Cost>& duals, const Float alpha)
+{
+    debug_assert(duals.size() == center_.size());
+    debug_assert(0.0 <= alpha && alpha <= 1.0);
+
+    const auto size = static_cast<Size>(duals.size());
+    for (Size i = 0; i < size; ++i)
+    {
+        stabilized_duals_[i] = alpha * center_[i] + (1.0 - alpha) * duals[i];
+    }
+    return stabilized_duals_;
+}
+
+void DualStabilization::update_center(const Vector<Cost>& priced_duals, const Float bound)
+{
+    debug_assert(priced_duals.size() == center_.size());
+    if (bound > center_bound_)
+    {
+        center_ = priced_duals;
+        center_bound_ = bound;
+        debugln("    Moving stability center with Lagrangian bound {}", bound);
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "types/basic_types.h"
+#include "types/vector.h"
+
+// Wentges smoothing of the dual values of the customer cover constraints. The duals used in pricing are a convex
+// combination of the stability center, the duals with the best Lagrangian bound found in the current node, and the
+// duals of the master problem.
+class DualStabilization
+{
+    // Stability center
+    Vector<Cost> center_;
+    Float center_bound_;
+    Int64 node_;
+
+    // Smoothing parameter
+    Float alpha_;
+
+    // Duals used in the last call to pricing
+    Vector<Cost> stabilized_duals_;
+
+  public:
+    // Constructors and destructor
+    DualStabilization(const Size num_customers);
+    DualStabilization() = delete;
+    DualStabilization(const DualStabilization&) = delete;
+    DualStabilization(DualStabilization&&) = delete;
+    DualStabilization& operator=(const DualStabilization&) = delete;
+    DualStabilization& operator=(DualStabilization&&) = delete;
+    ~DualStabilization() = default;
+
+    // Reset the stability center in a new node, optionally to some seed duals
+    void start(const Int64 node, const Vector<Cost>& duals, const Vector<Cost>* seed_duals = nullptr);
+
+    // Get the smoothing parameter after a number of mis-pricings in the current pricing call
+    Float alpha(const Size num_mispricings) const;
+
+    // Compute the duals to price
+    const Vector<Cost>& stabilize(const Vector<Cost>& duals, const Float alpha);
+
+    // Move the stability center to the priced duals if their Lagrangian bound improves on the center
+    void update_center(const Vector<Cost>& priced_duals, const Float bound);
+};
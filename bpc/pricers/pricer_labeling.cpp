@@ -4,14 +4,22 @@
 // #include "inequalities/subset_row_cut.h"
 // #include "problem/clock.h"
 #include "branching/constraint_handler_edge_branching.h"
-#include "labeling/labeling_algorithm.h"
+#include "labeling/pricing_capture.h"
+#include "labeling/q_route_relaxation.h"
 #include "output/formatting.h"
 #include "output/output.h"
+#include "pricers/column_pool.h"
+#include "pricers/dual_stabilization.h"
 #include "pricers/pricer_labeling.h"
+#include "pricers/pricing_effort.h"
+#include "pricers/pricing_portfolio.h"
+#include "pricers/volume_algorithm.h"
 #include "problem/problem.h"
 #include "problem/scip.h"
 #include "types/basic_types.h"
+#include "types/float_compare.h"
 #include "types/matrix.h"
+#include <algorithm>
 #include <scip/cons_linear.h>
 #include <scip/cons_setppc.h>
 
@@ -21,12 +29,385 @@
 #define PRICER_PRIORITY 1
 #define PRICER_DELAY    TRUE    // Only call pricer if all problem variables have non-negative reduced costs
 
+// Parameter holding the path of the file that captures the inputs of the labeling algorithms, empty if disabled
+#define PRICER_CAPTURE_FILE_PARAM "pricers/" PRICER_NAME "/capturefile"
+
+// Maximum number of paths taken from the column pool in each call
+#define PRICER_COLUMN_POOL_MAX_PATHS (500)
+
+// Rebuild the reduced cost matrix after this many incremental updates to discard accumulated rounding errors
+#define PRICER_REDUCED_COST_REBUILD_INTERVAL (100)
+
+// Stop column generation in a node below the root if the LP objective value decreases by less than this fraction
+// over this many pricing calls
+#define PRICER_TAILING_OFF_NUM_CALLS          (10)
+#define PRICER_TAILING_OFF_RELATIVE_DECREASE  (1e-3)
+
+// Delete a column from the master problem once it is nonbasic with a reduced cost above the threshold in this many
+// consecutive pricing calls, and delete the oldest columns first if the master problem has too many columns
+#define PRICER_COLUMN_AGE_LIMIT              (10)
+#define PRICER_COLUMN_AGING_MIN_REDUCED_COST (1.0)
+#define PRICER_MAX_NUM_COLUMNS               (5000)
+
+// Eliminate arcs by reduced cost in the root node and in the nodes at multiples of this depth
+#define PRICER_ARC_ELIMINATION_DEPTH_INTERVAL (5)
+
+// Arc elimination bounds the reduced cost of the paths using each arc with the q-route relaxation
+#if defined(USE_ARC_ELIMINATION) && !defined(USE_Q_ROUTE_PRICING)
+#error "USE_ARC_ELIMINATION requires USE_Q_ROUTE_PRICING"
+#endif
+
+// Pricer data
+struct PricerLabelingData
+{
+    PricingPortfolio portfolio;                   // Labeling algorithms
+    PricingEffortController effort_controller;    // Budget of each call to the labeling algorithms
+    ColumnPool column_pool;                       // Paths with negative reduced cost not yet added
+#ifdef USE_COLUMN_AGING
+    Vector<Size> column_ages;                     // Number of consecutive pricing calls each column has aged
+    Vector<Size> old_columns;                     // Columns that can be deleted
+#endif
+#ifdef USE_DUAL_STABILIZATION
+    DualStabilization dual_stabilization;         // Smoothing of the duals
+#endif
+#ifdef USE_Q_ROUTE_PRICING
+    QRouteRelaxation q_route;                     // Relaxation giving bounds and heuristic paths
+#endif
+#ifdef USE_ARC_ELIMINATION
+    Matrix<Cost> arc_bounds;                      // Lower bound on the reduced cost of the paths using each arc
+    Vector<Edge> eliminated_arcs;                 // Arcs eliminated in the current call
+    Int64 arc_elimination_node;                   // Node of the last arc elimination
+    Cost arc_elimination_cutoff_bound;            // Cutoff bound of the last arc elimination
+#endif
+#ifdef USE_VOLUME_ALGORITHM
+    VolumeAlgorithm volume_algorithm;             // Warm start of the root node
+    Bool volume_algorithm_done;                   // Indicates if the volume algorithm has run
+#endif
+    Vector<PricedPath> q_route_paths;             // Paths found by the q-route relaxation
+    Vector<Cost> duals;                           // Dual value of each customer cover constraint
+    Vector<Cost> priced_duals;                    // Duals subtracted in the reduced cost matrix
+    UInt64 reduced_cost_branching_version;        // Version of the branching decisions in the reduced cost matrix
+    Bool reduced_cost_feasible_master;            // Indicates if the reduced cost matrix holds the arc costs
+    Size reduced_cost_num_updates;                // Number of incremental updates since the last rebuild
+    Vector<PricedPath> pool_paths;                // Paths taken from the column pool
+    Vector<Vector<Vertex>> new_paths;             // Paths to add to the master problem
+    Vector<Cost> seed_duals;                      // Final duals of the parent node, or of the volume algorithm
+    Bool has_seed_duals;                          // Indicates if the seed duals are available
+    Int64 seeded_node;                            // Node seeded with the data of its parent
+    Cost min_path_cost;                           // Lower bound on the cost of any path
+    Int64 labeling_node;                          // Node of the labels stored in the labeling algorithms
+    UInt64 labeling_branching_version;            // Version of the branching decisions of the stored labels
+    Int64 lp_obj_history_node;                    // Node of the LP objective values in the history
+    Vector<Float> lp_obj_history;                 // LP objective value in each pricing call of the current node
+    UniquePtr<PricingCaptureWriter> capture;      // Writer of the inputs of the labeling algorithms
+
+    PricerLabelingData(const Instance& instance) :
+        portfolio(instance),
+        effort_controller(),
+        column_pool(instance),
+#ifdef USE_COLUMN_AGING
+        column_ages(),
+        old_columns(),
+#endif
+#ifdef USE_DUAL_STABILIZATION
+        dual_stabilization(instance.num_customers()),
+#endif
+#ifdef USE_Q_ROUTE_PRICING
+        q_route(instance),
+#endif
+#ifdef USE_ARC_ELIMINATION
+        arc_bounds(instance.num_vertices(), instance.num_vertices()),
+        arc_elimination_node(-1),
+        arc_elimination_cutoff_bound(std::numeric_limits<Cost>::infinity()),
+#endif
+#ifdef USE_VOLUME_ALGORITHM
+        volume_algorithm(instance),
+        volume_algorithm_done(false),
+#endif
+        q_route_paths(),
+        duals(instance.num_customers()),
+        priced_duals(instance.num_customers()),
+        reduced_cost_branching_version(std::numeric_limits<UInt64>::max()),
+        reduced_cost_feasible_master(false),
+        reduced_cost_num_updates(0),
+        pool_paths(),
+        new_paths(),
+        seed_duals(instance.num_customers()),
+        has_seed_duals(false),
+        seeded_node(-1),
+        min_path_cost(0.0),
+        labeling_node(-1),
+        labeling_branching_version(std::numeric_limits<UInt64>::max()),
+        lp_obj_history_node(-1),
+        lp_obj_history(),
+        capture()
+    {
+        // Every path leaves and returns to the depot.
+        const auto depot = instance.depot();
+        auto min_out = std::numeric_limits<Cost>::infinity();
+        auto min_in = std::numeric_limits<Cost>::infinity();
+        for (Vertex i = 0; i < instance.num_customers(); ++i)
+        {
+            if (instance.is_valid(depot, i))
+            {
+                min_out = std::min(min_out, instance.cost(depot, i));
+            }
+            if (instance.is_valid(i, depot))
+            {
+                min_in = std::min(min_in, instance.cost(i, depot));
+            }
+        }
+        min_path_cost = std::max(min_out + min_in, 0.0);
+
+        // Prune labels using the completion bounds of the q-route relaxation.
+#ifdef USE_Q_ROUTE_PRICING
+        portfolio.set_completion_bounds(&q_route);
+#endif
+    }
+};
+
+// Calculate the reduced cost of a path
+static Cost calculate_path_reduced_cost(const Instance& instance, const Vector<Cost>& duals, const Vector<Vertex>& path)
+{
+    Cost reduced_cost = 0;
+    for (Size idx = 0; idx < static_cast<Size>(path.size()) - 1; ++idx)
+    {
+        reduced_cost += instance.cost(path[idx], path[idx + 1]);
+    }
+    for (Size idx = 1; idx < static_cast<Size>(path.size()) - 1; ++idx)
+    {
+        reduced_cost -= duals[path[idx]];
+    }
+    return reduced_cost;
+}
+
+// Get an upper bound on the number of paths in any solution better than the incumbent
+static Size calculate_fleet_bound(SCIP* scip, const Size num_customers, const Cost min_path_cost)
+{
+    Size fleet_bound = num_customers;
+    const auto upper_bound = SCIPgetUpperbound(scip);
+    if (!SCIPisInfinity(scip, upper_bound) && min_path_cost > 0.0)
+    {
+        fleet_bound = std::min<Size>(fleet_bound, eps_floor(upper_bound / min_path_cost));
+    }
+    return fleet_bound;
+}
+
+// Check if column generation in the current node should stop and branch
+static Bool check_early_termination(
+    SCIP* scip,                         // SCIP
+    Problem& problem,                   // Problem
+    PricerLabelingData& pricer_data,    // Pricer data
+    const Int64 node,                   // Number of the current node
+    const Cost lagrangian_bound         // Lagrangian bound in this call, or -infinity if not computed
+)
+{
+    // Get the LP objective value.
+    const auto lp_obj = SCIPgetLPObjval(scip);
+
+    // Update the history of the LP objective value.
+    auto& lp_obj_history = pricer_data.lp_obj_history;
+    if (pricer_data.lp_obj_history_node != node)
+    {
+        pricer_data.lp_obj_history_node = node;
+        lp_obj_history.clear();
+    }
+    lp_obj_history.push_back(lp_obj);
+
+    // Stop if the node can be pruned.
+    const auto cutoff_bound = SCIPgetCutoffbound(scip);
+    if (!SCIPisInfinity(scip, cutoff_bound) && SCIPisGE(scip, lagrangian_bound, cutoff_bound))
+    {
+        debugln("    Stopping early in node {} due to Lagrangian bound {} exceeding cutoff bound {}",
+                node, lagrangian_bound, cutoff_bound);
+        return true;
+    }
+
+    // Otherwise stopping early requires branching, which is only possible if the LP solution has fractional edges.
+    const auto rounded_bound_reached = eps_ceil(lagrangian_bound) >= eps_ceil(lp_obj);
+    const auto num_calls = static_cast<Size>(lp_obj_history.size());
+    const auto tailing_off =
+        SCIPgetDepth(scip) > 0 &&
+        num_calls > PRICER_TAILING_OFF_NUM_CALLS &&
+        lp_obj_history[num_calls - 1 - PRICER_TAILING_OFF_NUM_CALLS] - lp_obj <
+            PRICER_TAILING_OFF_RELATIVE_DECREASE * std::max(std::abs(lp_obj), 1.0);
+    if (rounded_bound_reached || tailing_off)
+    {
+        problem.update_variable_values(scip);
+        if (!problem.fractional_edges.empty())
+        {
+            debugln("    Stopping early in node {} with Lagrangian bound {} and LP objective value {}{}",
+                    node, lagrangian_bound, lp_obj, tailing_off ? " due to tailing off" : "");
+            return true;
+        }
+    }
+
+    // Continue.
+    return false;
+}
+
+// Forbid the arcs that cannot be used by any solution better than the incumbent in the subtree of the current node.
+// A solution using a path costs at least the sum of the duals plus the reduced cost of the path plus the minimum
+// reduced cost for each other vehicle, and the reduced cost of the paths using an arc is bounded by joining the
+// forward and backward states of the q-route relaxation. The arcs are forbidden by one local edge branching constraint,
+// so the descendants inherit them, their columns are fixed to zero and the arcs are disabled in the reduced cost
+// matrix.
+#ifdef USE_ARC_ELIMINATION
+static void eliminate_arcs(
+    SCIP* scip,                         // SCIP
+    const Problem& problem,             // Problem
+    PricerLabelingData& pricer_data,    // Pricer data
+    const Int64 node,                   // Number of the current node
+    const Cost base_bound               // Lower bound on the cost of a solution without the reduced cost of one path
+)
+{
+    // Eliminate arcs once for every incumbent in the selected nodes.
+    const auto cutoff_bound = SCIPgetCutoffbound(scip);
+    if (SCIPinProbing(scip) ||
+        SCIPisInfinity(scip, cutoff_bound) ||
+        SCIPgetDepth(scip) % PRICER_ARC_ELIMINATION_DEPTH_INTERVAL != 0 ||
+        (pricer_data.arc_elimination_node == node &&
+         !SCIPisLT(scip, cutoff_bound, pricer_data.arc_elimination_cutoff_bound)))
+    {
+        return;
+    }
+    pricer_data.arc_elimination_node = node;
+    pricer_data.arc_elimination_cutoff_bound = cutoff_bound;
+
+    // Get instance.
+    const auto& instance = *problem.instance;
+    const auto num_vertices = instance.num_vertices();
+
+    // Bound the reduced cost of the paths using each arc.
+    const auto& reduced_cost = pricer_data.portfolio.get_reduced_cost_matrix();
+    auto& arc_bounds = pricer_data.arc_bounds;
+    pricer_data.q_route.calculate_arc_bounds(reduced_cost, arc_bounds);
+
+    // Find the arcs to eliminate. Arcs that are already disabled are skipped.
+    auto& eliminated_arcs = pricer_data.eliminated_arcs;
+    eliminated_arcs.clear();
+    for (Vertex i = 0; i < num_vertices; ++i)
+        for (Vertex j = 0; j < num_vertices; ++j)
+            if (i != j &&
+                !std::isnan(reduced_cost(i, j)) &&
+                SCIPisGE(scip, base_bound + arc_bounds(i, j), cutoff_bound))
+            {
+                eliminated_arcs.push_back(Edge{i, j});
+            }
+
+    // Forbid the arcs.
+    if (!eliminated_arcs.empty())
+    {
+        auto current_node = SCIPgetCurrentNode(scip);
+        SCIP_Cons* cons;
+        const auto name = fmt::format("eliminate_arcs({})", node);
+        scip_assert(SCIPcreateConsEdgeBranching(scip,
+                                                &cons,
+                                                name.c_str(),
+                                                current_node,
+                                                eliminated_arcs,
+                                                BranchDirection::Forbid,
+                                                true));
+        scip_assert(SCIPaddConsNode(scip, current_node, cons, nullptr));
+        scip_assert(SCIPreleaseCons(scip, &cons));
+    }
+    debugln("    Eliminated {} arcs in node {} with cutoff bound {}", eliminated_arcs.size(), node, cutoff_bound);
+}
+#endif
+
+// Age the columns of the master problem and delete the old ones. A column ages if it is nonbasic with a large
+// reduced cost or if SCIP removed it from the LP. The paths of the deleted columns go to the column pool, which adds
+// them again if their reduced cost becomes negative.
+#ifdef USE_COLUMN_AGING
+static void age_columns(
+    SCIP* scip,                       // SCIP
+    Problem& problem,                 // Problem
+    PricerLabelingData& pricer_data   // Pricer data
+)
+{
+    // Ages are only meaningful with an optimal basis.
+    if (!SCIPisLPSolBasic(scip))
+    {
+        return;
+    }
+
+    // Update the age of every column.
+    const auto& vars = problem.vars;
+    const auto num_vars = static_cast<Size>(vars.size());
+    auto& column_ages = pricer_data.column_ages;
+    auto& old_columns = pricer_data.old_columns;
+    column_ages.resize(num_vars, 0);
+    old_columns.clear();
+    Size num_columns = 0;
+    for (Size v = 0; v < num_vars; ++v)
+    {
+        // Skip deleted columns.
+        const auto var = vars.var(v);
+        if (SCIPvarIsDeleted(var))
+        {
+            continue;
+        }
+        ++num_columns;
+
+        // Update the age.
+        auto& age = column_ages[v];
+        if (SCIPvarIsInLP(var) &&
+            (SCIPcolGetBasisStatus(SCIPvarGetCol(var)) == SCIP_BASESTAT_BASIC ||
+             SCIPgetVarRedcost(scip, var) < PRICER_COLUMN_AGING_MIN_REDUCED_COST))
+        {
+            age = 0;
+        }
+        else
+        {
+            ++age;
+        }
+
+        // Store the candidates for deletion.
+        if (age > 0 && !SCIPisPositive(scip, SCIPgetSolVal(scip, nullptr, var)))
+        {
+            old_columns.push_back(v);
+        }
+    }
+
+    // Delete the columns that reached the age limit and the oldest columns above the size limit. Columns in a stored
+    // solution are kept.
+    std::sort(old_columns.begin(),
+              old_columns.end(),
+              [&column_ages](const Size a, const Size b) { return column_ages[a] > column_ages[b]; });
+    const auto num_sols = SCIPgetNSols(scip);
+    const auto sols = SCIPgetSols(scip);
+    Size num_deleted = 0;
+    for (const auto v : old_columns)
+    {
+        // Stop once all the remaining columns are young enough.
+        if (column_ages[v] < PRICER_COLUMN_AGE_LIMIT && num_columns <= PRICER_MAX_NUM_COLUMNS)
+        {
+            break;
+        }
+
+        // Delete the column.
+        const auto& [var, _, path] = vars[v];
+        if (std::none_of(sols, sols + num_sols, [scip, var](SCIP_Sol* sol)
+                         {
+                             return SCIPisPositive(scip, SCIPgetSolVal(scip, sol, var));
+                         }) &&
+            problem.delete_priced_var(scip, v))
+        {
+            pricer_data.column_pool.add(path);
+            --num_columns;
+            ++num_deleted;
+        }
+    }
+    debugln("    Deleted {} old columns, {} columns remaining", num_deleted, num_columns);
+}
+#endif
+
 static void run_labeling_pricer(
     SCIP* scip,                    // SCIP
     SCIP_Pricer* pricer,           // Pricer
     const Bool feasible_master,    // Indicates if the master problem is feasible
     SCIP_Result* result,           // Output result
-    SCIP_Bool*,                    // Output flag to indicate early branching is required
+    SCIP_Bool* stop_early,         // Output flag to indicate early branching is required
     SCIP_Real* lower_bound         // Output lower bound
 )
 {
@@ -59,7 +440,6 @@ static void run_labeling_pricer(
     const auto& instance = *problem.instance;
     const auto num_customers = instance.num_customers();
     const auto num_vertices = instance.num_vertices();
-    const auto depot = instance.depot();
 
     // Print solution.
 // #ifdef PRINT_DEBUG
@@ -72,26 +452,19 @@ static void run_labeling_pricer(
 // #endif
 
     // Get solver.
-    auto& labeling_algorithm = *reinterpret_cast<LabelingAlgorithm*>(SCIPpricerGetData(pricer));
+    auto& pricer_data = *reinterpret_cast<PricerLabelingData*>(SCIPpricerGetData(pricer));
+    auto& portfolio = pricer_data.portfolio;
+    auto& effort_controller = pricer_data.effort_controller;
+    auto& column_pool = pricer_data.column_pool;
+    auto& duals = pricer_data.duals;
 
-    // Create matrix of reduced costs.
-    auto& reduced_cost = labeling_algorithm.get_reduced_cost_matrix();
-    if (feasible_master)
-    {
-        reduced_cost = instance.cost;
-    }
-    else
-    {
-        reduced_cost.set(0.0);
-        for (Vertex i = 0; i < num_vertices; ++i)
-            for (Vertex j = 0; j < num_vertices; ++j)
-                if (!instance.is_valid(i, j))
-                {
-                    reduced_cost(i, j) = nan;
-                }
-    }
+    // Repair the incumbent if it covers customers more than once. Its paths can need new variables, which can only be
+    // added during pricing.
+#if defined(USE_SET_COVERING) || defined(USE_DUAL_OPTIMAL_INEQUALITIES)
+    problem.repair_solution(scip, nullptr, true);
+#endif
 
-    // Modify the reduced cost matrix for customer cover constraints.
+    // Get the dual values of the customer cover constraints.
     // debugln("    Dual variable values:");
     {
         const auto& customer_cover_conss = problem.customer_cover_conss;
@@ -104,14 +477,17 @@ static void run_labeling_pricer(
             // Check that the constraint is not (locally) disabled/redundant.
             debug_assert(SCIPconsIsEnabled(cons));
 
-            // Get the dual value.
-            const auto dual = feasible_master ? SCIPgetDualsolLinear(scip, cons) : SCIPgetDualfarkasLinear(scip, cons);
-
-            // Modify the reduced cost matrix.
-            for (Vertex j = 0; j < num_vertices; ++j)
-            {
-                reduced_cost(i, j) -= dual;
-            }
+            // Get the dual value. The duals of the set covering constraints are non-negative up to the tolerances of
+            // the LP solver. Labeling keeps the dominance rules of set partitioning. Non-negative duals would let a
+            // label dominate another whose cost exceeds its own by the duals of the customers only the latter can
+            // still visit, since these customers can be dropped from any extension, but dropping a customer can use an
+            // arc forbidden by branching or remove a required one, so this only holds at the root node.
+            auto dual = feasible_master ? SCIPgetDualsolLinear(scip, cons) : SCIPgetDualfarkasLinear(scip, cons);
+#ifdef USE_SET_COVERING
+            debug_assert(SCIPisFeasGE(scip, dual, 0.0));
+            dual = std::max(dual, 0.0);
+#endif
+            duals[i] = dual;
 
             // Print.
             debugln("        {} = {}", SCIPconsGetName(cons), dual);
@@ -203,53 +579,46 @@ static void run_labeling_pricer(
 //     }
 // #endif
 
-    // Enforce the edge branching decisions.
+    // Rebuild the reduced cost matrix without duals if the branching decisions or the type of pricing changed.
+    // Otherwise the matrix is updated row by row from the previously priced duals to the new duals. Disabled arcs stay
+    // NaN under the updates.
+    const auto node = SCIPnodeGetNumber(SCIPgetCurrentNode(scip));
+    const auto branching_version = SCIPgetEdgeBranchingVersion(problem.edge_branching_conshdlr);
+    auto& reduced_cost = portfolio.get_reduced_cost_matrix();
+    auto& priced_duals = pricer_data.priced_duals;
+    if (pricer_data.reduced_cost_branching_version != branching_version ||
+        pricer_data.reduced_cost_feasible_master != feasible_master ||
+        pricer_data.reduced_cost_num_updates >= PRICER_REDUCED_COST_REBUILD_INTERVAL)
     {
-        auto edge_branching_conshdlr = problem.edge_branching_conshdlr;
-        auto edge_branching_conss = SCIPconshdlrGetConss(edge_branching_conshdlr);
-        const auto num_edge_branching_conss = SCIPconshdlrGetNConss(edge_branching_conshdlr);
-        for (Size idx = 0; idx < num_edge_branching_conss; ++idx)
-        {
-            // Get the constraint.
-            auto cons = edge_branching_conss[idx];
-            debug_assert(cons);
-
-            // Ignore constraints that are not active since these are not on the current active path of the search tree.
-            if (!SCIPconsIsActive(cons))
-            {
-                continue;
-            }
+        pricer_data.reduced_cost_branching_version = branching_version;
+        pricer_data.reduced_cost_feasible_master = feasible_master;
+        pricer_data.reduced_cost_num_updates = 0;
+        std::fill(priced_duals.begin(), priced_duals.end(), 0.0);
 
-            // Enforce the decision.
-            const auto [edge, dir] = SCIPgetEdgeBranchingDecision(cons);
-            if (dir == BranchDirection::Forbid)
-            {
-                reduced_cost(edge.i, edge.j) = nan;
-                debugln("    Disabling ({},{}) by branching", edge.i, edge.j);
-            }
-            else
+        // Create matrix of reduced costs and enforce the edge branching decisions.
+        const auto& num_disabling_decisions = SCIPgetEdgeBranchingDisabledArcs(problem.edge_branching_conshdlr);
+        for (Vertex i = 0; i < num_vertices; ++i)
+            for (Vertex j = 0; j < num_vertices; ++j)
             {
-                if (edge.j != depot)
+                if (num_disabling_decisions(i, j) > 0)
                 {
-                    for (Vertex i = 0; i < num_vertices; ++i)
-                        if (i != edge.i)
-                        {
-                            reduced_cost(i, edge.j) = nan;
-                            debugln("    Disabling ({},{}) by branching", i, edge.j);
-                        }
+                    reduced_cost(i, j) = nan;
                 }
-
-                if (edge.i != depot)
+                else if (feasible_master)
                 {
-                    for (Vertex j = 0; j < num_vertices; ++j)
-                        if (j != edge.j)
-                        {
-                            reduced_cost(edge.i, j) = nan;
-                            debugln("    Disabling ({},{}) by branching", edge.i, j);
-                        }
+                    reduced_cost(i, j) = instance.cost(i, j);
+                }
+                else
+                {
+                    reduced_cost(i, j) = instance.is_valid(i, j) ? 0.0 : nan;
                 }
             }
+#ifdef PRINT_DEBUG
+        for (const auto [edge, dir] : SCIPgetActiveEdgeBranchingDecisions(problem.edge_branching_conshdlr))
+        {
+            debugln("    Enforcing branching decision {} ({},{})", dir, edge.i, edge.j);
         }
+#endif
     }
 
     // Inject debug solution.
@@ -434,9 +803,310 @@ static void run_labeling_pricer(
 //    reduced_cost.print();
 // #endif
 
-    // Solve.
-    debugln("    Starting labeling algorithm");
-    labeling_algorithm.solve(scip, problem, feasible_master, result, lower_bound);
+    // In the first call of a new node, take the final duals and positive columns of the parent node. The columns
+    // that have since been deleted from the master problem go to the column pool, which excludes the ones disabled by
+    // the branching decision of the node.
+    if (pricer_data.seeded_node != node)
+    {
+        pricer_data.seeded_node = node;
+        pricer_data.has_seed_duals = false;
+        if (const auto parent_warm_start = problem.take_node_warm_start(scip))
+        {
+            debug_assert(static_cast<Size>(parent_warm_start->duals.size()) == num_customers);
+            std::copy(parent_warm_start->duals.begin(),
+                      parent_warm_start->duals.end(),
+                      pricer_data.seed_duals.begin());
+            pricer_data.has_seed_duals = true;
+            Size num_seeded_paths = 0;
+            for (const auto& path : parent_warm_start->paths)
+                if (!problem.vars.contains(path))
+                {
+                    column_pool.add(path);
+                    ++num_seeded_paths;
+                }
+            debugln("    Seeding node {} with the duals and {} deleted paths of its parent", node, num_seeded_paths);
+        }
+    }
+
+    // In the first call at the root node, estimate the optimal duals and find initial paths using the volume
+    // algorithm. The duals become the stability center and the paths are added instead of pricing.
+#ifdef USE_VOLUME_ALGORITHM
+    if (!pricer_data.volume_algorithm_done && SCIPgetDepth(scip) == 0)
+    {
+        pricer_data.volume_algorithm_done = true;
+        auto& volume_algorithm = pricer_data.volume_algorithm;
+        if (volume_algorithm.enabled())
+        {
+            // Get an upper bound, or the cost of serving every customer using its own path.
+            Float upper_bound = SCIPgetUpperbound(scip);
+            if (SCIPisInfinity(scip, upper_bound))
+            {
+                const auto depot = instance.depot();
+                upper_bound = 0.0;
+                for (Vertex i = 0; i < num_customers; ++i)
+                    if (instance.is_valid(depot, i) && instance.is_valid(i, depot))
+                    {
+                        upper_bound += instance.cost(depot, i) + instance.cost(i, depot);
+                    }
+            }
+
+            // Solve.
+            const auto fleet_bound = calculate_fleet_bound(scip, num_customers, pricer_data.min_path_cost);
+            volume_algorithm.solve(fleet_bound, upper_bound);
+            std::copy(volume_algorithm.duals().begin(),
+                      volume_algorithm.duals().end(),
+                      pricer_data.seed_duals.begin());
+            pricer_data.has_seed_duals = true;
+
+            // Add the paths.
+            auto& paths = volume_algorithm.paths();
+            debugln("    Volume algorithm found Lagrangian bound {} and {} paths",
+                    volume_algorithm.bound(), paths.size());
+            if (problem.add_priced_vars(scip, paths) > 0)
+            {
+                *result = SCIP_SUCCESS;
+                return;
+            }
+        }
+    }
+#endif
+
+    // Delete old columns from the master problem.
+#ifdef USE_COLUMN_AGING
+    if (feasible_master)
+    {
+        age_columns(scip, problem, pricer_data);
+    }
+#endif
+
+    // Take paths with negative reduced cost from the column pool and skip labeling if any of them are new.
+    {
+        auto& pool_paths = pricer_data.pool_paths;
+        pool_paths.clear();
+        column_pool.reprice(feasible_master, duals, reduced_cost, PRICER_COLUMN_POOL_MAX_PATHS, pool_paths);
+        if (!pool_paths.empty())
+        {
+            debugln("    Adding {} paths from the column pool", pool_paths.size());
+            auto& new_paths = pricer_data.new_paths;
+            debug_assert(new_paths.empty());
+            for (auto& [_, path] : pool_paths)
+            {
+                new_paths.push_back(std::move(path));
+            }
+            if (problem.add_priced_vars(scip, new_paths) > 0)
+            {
+                *result = SCIP_SUCCESS;
+                return;
+            }
+        }
+    }
+
+    // Decide the budget.
+    const auto budget = effort_controller.start(SCIPgetSolvingTime(scip),
+                                                node,
+                                                feasible_master,
+                                                feasible_master ? SCIPgetLPObjval(scip) : nan);
+
+    // Reset the stability center in a new node.
+#ifdef USE_DUAL_STABILIZATION
+    auto& dual_stabilization = pricer_data.dual_stabilization;
+    if (feasible_master)
+    {
+        dual_stabilization.start(node, duals, pricer_data.has_seed_duals ? &pricer_data.seed_duals : nullptr);
+    }
+#endif
+
+    // Solve. If the duals are stabilized, the reduced cost of the paths is recomputed using the duals of the master
+    // problem. If none of the paths have negative reduced cost, the weight of the stability center is lowered and
+    // pricing is repeated until the duals of the master problem are priced.
+    Size num_new_paths = 0;
+    Size num_labeling_iterations = 0;
+    auto lagrangian_bound = -std::numeric_limits<Cost>::infinity();
+#ifdef USE_ARC_ELIMINATION
+    auto arc_elimination_bound = -std::numeric_limits<Cost>::infinity();
+#endif
+    for (Size num_mispricings = 0; ; ++num_mispricings)
+    {
+        // Get the duals to price.
+#ifdef USE_DUAL_STABILIZATION
+        const auto alpha = feasible_master ? dual_stabilization.alpha(num_mispricings) : 0.0;
+        const auto& pricing_duals = alpha > 0.0 ? dual_stabilization.stabilize(duals, alpha) : duals;
+#else
+        const Float alpha = 0.0;
+        const auto& pricing_duals = duals;
+#endif
+
+        // Shift the reduced cost matrix from the previously priced duals to the new duals.
+        for (Vertex i = 0; i < num_customers; ++i)
+            if (priced_duals[i] != pricing_duals[i])
+            {
+                const auto shift = priced_duals[i] - pricing_duals[i];
+                for (auto it = reduced_cost.begin(i); it != reduced_cost.end(i); ++it)
+                {
+                    *it += shift;
+                }
+                priced_duals[i] = pricing_duals[i];
+            }
+        ++pricer_data.reduced_cost_num_updates;
+
+        // Solve the q-route relaxation. It bounds the reduced cost of every path, gives completion bounds to the
+        // labeling algorithms and finds some elementary paths.
+        Size num_rejected_paths = 0;
+        auto& q_route_paths = pricer_data.q_route_paths;
+        q_route_paths.clear();
+#ifdef USE_Q_ROUTE_PRICING
+        auto& q_route = pricer_data.q_route;
+        const auto add_q_route_path = [&](Vector<Vertex>&& path, const Cost path_reduced_cost)
+        {
+            if (problem.vars.contains(path))
+            {
+                ++num_rejected_paths;
+            }
+            else
+            {
+                q_route_paths.push_back({path_reduced_cost, std::move(path)});
+            }
+        };
+        q_route.solve(reduced_cost, add_q_route_path);
+        debugln("    Q-route relaxation found {} paths with lower bound {}", q_route_paths.size(), q_route.obj());
+#endif
+
+        // Run the labeling algorithms if the q-route relaxation found no paths that are not in the master problem.
+        const auto run_labeling = q_route_paths.empty();
+        if (run_labeling)
+        {
+            debugln("    Starting labeling algorithm with stabilization parameter {}", alpha);
+#ifdef USE_WARM_START_LABELING
+            const auto warm_start = feasible_master &&
+                                    pricer_data.labeling_node == node &&
+                                    pricer_data.labeling_branching_version == branching_version;
+#else
+            const Bool warm_start = false;
+#endif
+            if (pricer_data.capture)
+            {
+                pricer_data.capture->write(reduced_cost, feasible_master, budget);
+            }
+            portfolio.solve(scip, feasible_master, budget, warm_start);
+            pricer_data.labeling_node = feasible_master ? node : -1;
+            pricer_data.labeling_branching_version = branching_version;
+            num_labeling_iterations += portfolio.exact_labeling_algorithm().num_iterations();
+            num_rejected_paths += portfolio.num_rejected_paths();
+
+            // Store the paths that were set aside in the column pool.
+            for (const auto& [_, path] : portfolio.spare_paths())
+            {
+                column_pool.add(path);
+            }
+        }
+
+        // Add the new paths. Paths that do not have negative reduced cost under the duals of the master problem are
+        // stored in the column pool.
+        auto& new_paths = pricer_data.new_paths;
+        debug_assert(new_paths.empty());
+        for (auto& [path_reduced_cost, path] : run_labeling ? portfolio.paths() : q_route_paths)
+        {
+            if (alpha > 0.0)
+            {
+                path_reduced_cost = calculate_path_reduced_cost(instance, duals, path);
+            }
+            if (alpha == 0.0 || is_lt(path_reduced_cost, 0.0))
+            {
+                column_pool.remove(path);
+                new_paths.push_back(std::move(path));
+            }
+            else
+            {
+                column_pool.add(path);
+            }
+        }
+        const auto num_candidate_paths = static_cast<Size>(new_paths.size());
+        const auto num_added_paths = problem.add_priced_vars(scip, new_paths);
+        num_rejected_paths += num_candidate_paths - num_added_paths;
+        num_new_paths += num_added_paths;
+
+        // Get a lower bound on the reduced cost of every path from the exact algorithm if it finished and from the
+        // q-route relaxation.
+        auto min_reduced_cost = -std::numeric_limits<Cost>::infinity();
+        if (const auto& exact_labeling_algorithm = portfolio.exact_labeling_algorithm();
+            run_labeling && exact_labeling_algorithm.completed())
+        {
+            min_reduced_cost = std::min(exact_labeling_algorithm.obj(), 0.0);
+        }
+#ifdef USE_Q_ROUTE_PRICING
+        if (q_route.solved())
+        {
+            min_reduced_cost = std::max(min_reduced_cost, std::min(q_route.obj(), 0.0));
+        }
+#endif
+
+        // Compute the Lagrangian bound of the priced duals.
+        if (feasible_master && min_reduced_cost > -std::numeric_limits<Cost>::infinity())
+        {
+            const auto fleet_bound = calculate_fleet_bound(scip, num_customers, pricer_data.min_path_cost);
+            Cost bound = fleet_bound * min_reduced_cost;
+            for (Vertex i = 0; i < num_customers; ++i)
+            {
+                bound += pricing_duals[i];
+            }
+#ifdef USE_REDUCED_COST_FIXING
+            if (problem.fixing_node != node || bound > problem.fixing_bound)
+            {
+                problem.fixing_node = node;
+                problem.fixing_bound = bound;
+                std::copy(pricing_duals.begin(), pricing_duals.end(), problem.fixing_duals.begin());
+            }
+#endif
+#ifdef USE_ARC_ELIMINATION
+            arc_elimination_bound = q_route.solved() ? bound - min_reduced_cost :
+                                                       -std::numeric_limits<Cost>::infinity();
+#endif
+#ifdef USE_DUAL_STABILIZATION
+            dual_stabilization.update_center(pricing_duals, bound);
+#endif
+
+            // Report the bound to SCIP. The cost of every solution is non-negative.
+            bound = std::max(bound, 0.0);
+            debugln("    Computed lower bound {} in node {}", bound, node);
+            if (lower_bound && bound > *lower_bound)
+            {
+                *lower_bound = bound;
+            }
+            lagrangian_bound = std::max(lagrangian_bound, bound);
+        }
+
+        // Stop if paths are found, the duals of the master problem are priced or the time limit is reached. The duals
+        // of the master problem are only priced if no path was discarded as a duplicate or if the exact algorithm
+        // finished, since the discarded paths can hide paths that are not in the master problem.
+        const auto exact_completed = run_labeling && portfolio.exact_labeling_algorithm().completed();
+        const auto priced = alpha == 0.0 && (num_rejected_paths == 0 || exact_completed);
+        if (num_new_paths > 0 || priced || SCIPisStopped(scip))
+        {
+            break;
+        }
+        debugln("    Mis-pricing with stabilization parameter {}", alpha);
+    }
+
+    // Record the outcome.
+    effort_controller.finish(SCIPgetSolvingTime(scip), num_new_paths, num_labeling_iterations);
+
+    // Stop column generation early.
+    if (stop_early && feasible_master && num_new_paths > 0)
+    {
+        *stop_early = check_early_termination(scip, problem, pricer_data, node, lagrangian_bound);
+    }
+
+    // Eliminate arcs using the last priced duals once column generation in the node converges or stops early.
+#ifdef USE_ARC_ELIMINATION
+    if (arc_elimination_bound > -std::numeric_limits<Cost>::infinity() &&
+        (num_new_paths == 0 || (stop_early && *stop_early)))
+    {
+        eliminate_arcs(scip, problem, pricer_data, node, arc_elimination_bound);
+    }
+#endif
+
+    // Set time out status.
+    *result = num_new_paths > 0 || !SCIPisStopped(scip) ? SCIP_SUCCESS : SCIP_DIDNOTRUN;
 }
 
 // Reduced cost pricing for feasible master problem
@@ -459,14 +1129,38 @@ static SCIP_DECL_PRICERFARKAS(pricerLabelingFarkas)
 }
 #pragma GCC diagnostic pop
 
+// Open the capture file at the start of the solve
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+static SCIP_DECL_PRICERINITSOL(pricerLabelingInitsol)
+{
+    auto& pricer_data = *reinterpret_cast<PricerLabelingData*>(SCIPpricerGetData(pricer));
+    char* capture_path = nullptr;
+    SCIP_CALL(SCIPgetStringParam(scip, PRICER_CAPTURE_FILE_PARAM, &capture_path));
+    if (capture_path && capture_path[0] != '\0')
+    {
+        const auto& problem = *reinterpret_cast<Problem*>(SCIPgetProbData(scip));
+        pricer_data.capture = std::make_unique<PricingCaptureWriter>(capture_path, *problem.instance);
+        println("Capturing pricing problems to {}", capture_path);
+    }
+
+    // Discard the paths already in the master problem during the search so that they do not use up the budget.
+    // These paths are only found again if their variable is fixed to zero in the node.
+    const auto& vars = reinterpret_cast<Problem*>(SCIPgetProbData(scip))->vars;
+    pricer_data.portfolio.set_path_filter([&vars](const Vector<Vertex>& path) { return vars.contains(path); });
+
+    return SCIP_OKAY;
+}
+#pragma GCC diagnostic pop
+
 // Free pricer data
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 static SCIP_DECL_PRICERFREE(pricerLabelingFree)
 {
-    auto labeling = reinterpret_cast<LabelingAlgorithm*>(SCIPpricerGetData(pricer));
-    debug_assert(labeling);
-    delete labeling;
+    auto pricer_data = reinterpret_cast<PricerLabelingData*>(SCIPpricerGetData(pricer));
+    debug_assert(pricer_data);
+    delete pricer_data;
 
     return SCIP_OKAY;
 }
@@ -476,7 +1170,7 @@ static SCIP_DECL_PRICERFREE(pricerLabelingFree)
 SCIP_Retcode SCIPincludePricerLabeling(SCIP* scip, const Instance& instance)
 {
     // Create labeling algorithm.
-    auto labeling = new LabelingAlgorithm(instance);
+    auto pricer_data = new PricerLabelingData(instance);
 
     // Include pricer.
     SCIP_Pricer* pricer;
@@ -488,12 +1182,23 @@ SCIP_Retcode SCIPincludePricerLabeling(SCIP* scip, const Instance& instance)
                                      PRICER_DELAY,
                                      pricerLabelingRedCost,
                                      pricerLabelingFarkas,
-                                     reinterpret_cast<SCIP_PricerData*>(labeling)));
+                                     reinterpret_cast<SCIP_PricerData*>(pricer_data)));
 
     // Activate pricer.
     SCIP_CALL(SCIPactivatePricer(scip, pricer));
+    SCIP_CALL(SCIPsetPricerInitsol(scip, pricer, pricerLabelingInitsol));
     SCIP_CALL(SCIPsetPricerFree(scip, pricer, pricerLabelingFree));
 
+    // Add parameters.
+    SCIP_CALL(SCIPaddStringParam(scip,
+                                 PRICER_CAPTURE_FILE_PARAM,
+                                 "path of the file that captures the inputs of the labeling algorithms",
+                                 nullptr,
+                                 FALSE,
+                                 "",
+                                 nullptr,
+                                 nullptr));
+
     // Done.
     return SCIP_OKAY;
 }
@@ -0,0 +1,144 @@
+// #define PRINT_DEBUG
+
+#include "pricers/pricing_effort.h"
+#include "problem/debug.h"
+#include <algorithm>
+#include <cmath>
+
+#define DEFAULT_MAX_PATHS         (2000)     // Budget of paths when the scale is 1
+#define DEFAULT_MAX_ITERATIONS    (20000)    // Budget of popped labels when the scale is 1
+#define MIN_PATH_SCALE            (0.05)
+#define MAX_PATH_SCALE            (2.0)
+#define MIN_ITERATION_SCALE       (0.1)
+#define MAX_ITERATION_SCALE       (8.0)
+#define PRICING_DOMINATES_RATIO   (2.0)      // Pricing is too slow if it takes this many times longer than the LP
+#define LP_DOMINATES_RATIO        (0.5)      // LP is too slow if pricing takes this fraction of the LP time
+#define TAILING_OFF_RATE_RATIO    (0.25)     // Search harder if the rate drops below this fraction of the average
+#define RATE_SMOOTHING            (0.7)      // Weight of the history in the moving average of the rate
+#define MIN_TIME                  (1e-4)     // Avoid division by zero for very fast calls
+
+PricingEffortController::PricingEffortController() :
+    path_scale_(1.0),
+    iteration_scale_(1.0),
+
+    has_previous_(false),
+    previous_node_(-1),
+    previous_lp_obj_(0.0),
+    previous_end_time_(0.0),
+    previous_pricing_time_(0.0),
+    previous_num_paths_(0),
+    previous_budget_{DEFAULT_MAX_PATHS, DEFAULT_MAX_ITERATIONS},
+
+    start_time_(0.0),
+
+    average_rate_(0.0)
+{
+}
+
+LabelingBudget PricingEffortController::start(
+    const Float time,              // Current solving time
+    const Int64 node,              // Number of the current node
+    const Bool feasible_master,    // Indicates if the master problem is feasible
+    const Float lp_obj             // LP objective value of the master problem if feasible
+)
+{
+    // Store the start time.
+    start_time_ = time;
+
+    // Use the default budget for Farkas pricing since the LP objective value is meaningless.
+    if (!feasible_master)
+    {
+        has_previous_ = false;
+        return {DEFAULT_MAX_PATHS, DEFAULT_MAX_ITERATIONS};
+    }
+
+    // Adjust the scales using the previous call at the same node.
+    if (has_previous_ && previous_node_ == node)
+    {
+        // Compute the time spent in the LP and the rate of improvement since the previous call.
+        const auto lp_time = std::max(time - previous_end_time_, MIN_TIME);
+        const auto iteration_time = lp_time + previous_pricing_time_;
+        const auto rate = std::max(previous_lp_obj_ - lp_obj, 0.0) / iteration_time;
+        const auto ratio = previous_pricing_time_ / lp_time;
+
+        // Balance the time spent in pricing and in the LP. If pricing dominates, stop the search earlier but accept
+        // more paths per call to amortize it. If the LP dominates, search longer for better paths but add fewer of
+        // them to keep the LP small.
+        if (ratio > PRICING_DOMINATES_RATIO)
+        {
+            iteration_scale_ *= 0.75;
+            path_scale_ *= 1.25;
+        }
+        else if (ratio < LP_DOMINATES_RATIO)
+        {
+            iteration_scale_ *= 1.25;
+            path_scale_ *= 0.8;
+        }
+
+        // Search harder if the LP objective value is tailing off.
+        if (average_rate_ > 0 && rate < TAILING_OFF_RATE_RATIO * average_rate_)
+        {
+            iteration_scale_ *= 1.5;
+        }
+
+        // Allow more paths if the previous call filled its budget of paths quickly.
+        if (previous_num_paths_ >= previous_budget_.max_paths && ratio <= PRICING_DOMINATES_RATIO)
+        {
+            path_scale_ *= 1.1;
+        }
+
+        // Clamp the scales.
+        path_scale_ = std::clamp(path_scale_, MIN_PATH_SCALE, MAX_PATH_SCALE);
+        iteration_scale_ = std::clamp(iteration_scale_, MIN_ITERATION_SCALE, MAX_ITERATION_SCALE);
+
+        // Update the average rate.
+        average_rate_ = average_rate_ > 0 ? RATE_SMOOTHING * average_rate_ + (1.0 - RATE_SMOOTHING) * rate : rate;
+
+        // Print.
+#ifdef PRINT_PRICING_EFFORT
+        println("Pricing effort at node {}: LP time {:.4f}, pricing time {:.4f}, ratio {:.2f}, LP obj decrease {:.4f}, "
+                "rate {:.4f}, average rate {:.4f}, paths {}, path scale {:.3f}, iteration scale {:.3f}",
+                node,
+                lp_time,
+                previous_pricing_time_,
+                ratio,
+                previous_lp_obj_ - lp_obj,
+                rate,
+                average_rate_,
+                previous_num_paths_,
+                path_scale_,
+                iteration_scale_);
+#endif
+    }
+
+    // Store the state of this call.
+    previous_node_ = node;
+    previous_lp_obj_ = lp_obj;
+    has_previous_ = true;
+
+    // Create the budget.
+    previous_budget_.max_paths = std::max<Size>(std::lround(DEFAULT_MAX_PATHS * path_scale_), 1);
+    previous_budget_.max_iterations = std::max<Size>(std::lround(DEFAULT_MAX_ITERATIONS * iteration_scale_), 1);
+    debugln("    Pricing budget of {} paths and {} iterations",
+            previous_budget_.max_paths, previous_budget_.max_iterations);
+    return previous_budget_;
+}
+
+void PricingEffortController::finish(
+    const Float time,            // Current solving time
+    const Size num_paths,        // Number of paths added to the master problem
+    const Size num_iterations    // Number of labels popped
+)
+{
+    previous_end_time_ = time;
+    previous_pricing_time_ = std::max(time - start_time_, MIN_TIME);
+    previous_num_paths_ = num_paths;
+
+    // Print.
+#ifdef PRINT_PRICING_EFFORT
+    println("Pricing call finished in {:.4f} seconds with {} paths after {} iterations",
+            previous_pricing_time_, num_paths, num_iterations);
+#else
+    static_cast<void>(num_iterations);
+#endif
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "labeling/labeling_algorithm.h"
+#include "types/basic_types.h"
+
+// Adaptive controller for the number of labels popped and paths generated in each call to the labeling algorithm
+class PricingEffortController
+{
+    // Current budget relative to the default budget
+    Float path_scale_;
+    Float iteration_scale_;
+
+    // Data of the previous call
+    Bool has_previous_;
+    Int64 previous_node_;
+    Float previous_lp_obj_;
+    Float previous_end_time_;
+    Float previous_pricing_time_;
+    Size previous_num_paths_;
+    LabelingBudget previous_budget_;
+
+    // Data of the current call
+    Float start_time_;
+
+    // Exponential moving average of the decrease in LP objective value per second
+    Float average_rate_;
+
+  public:
+    // Constructors and destructor
+    PricingEffortController();
+    PricingEffortController(const PricingEffortController&) = delete;
+    PricingEffortController(PricingEffortController&&) = delete;
+    PricingEffortController& operator=(const PricingEffortController&) = delete;
+    PricingEffortController& operator=(PricingEffortController&&) = delete;
+    ~PricingEffortController() = default;
+
+    // Decide the budget of a call to the labeling algorithm
+    LabelingBudget start(
+        const Float time,              // Current solving time
+        const Int64 node,              // Number of the current node
+        const Bool feasible_master,    // Indicates if the master problem is feasible
+        const Float lp_obj             // LP objective value of the master problem if feasible
+    );
+
+    // Record the outcome of a call to the labeling algorithm
+    void finish(
+        const Float time,            // Current solving time
+        const Size num_paths,        // Number of paths added to the master problem
+        const Size num_iterations    // Number of labels popped
+    );
+};
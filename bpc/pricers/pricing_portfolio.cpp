@@ -0,0 +1,184 @@
+// #define PRINT_DEBUG
+
+#include "pricers/pricing_portfolio.h"
+#include "problem/debug.h"
+#include <algorithm>
+#include <iterator>
+#ifdef USE_CONCURRENT_PRICING
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+#ifndef CONCURRENT_PRICING_POLL_INTERVAL
+#define CONCURRENT_PRICING_POLL_INTERVAL (5)    // Milliseconds between checks of the SCIP time limit
+#endif
+
+PricingPortfolio::PricingPortfolio(const Instance& instance) :
+    reduced_cost_(instance.num_vertices(), instance.num_vertices()),
+    labeling_algorithms_(),
+    paths_(),
+    spare_paths_()
+{
+    labeling_algorithms_.push_back(std::make_unique<LabelingAlgorithm>(instance, LabelingMode::Exact));
+#ifdef USE_CONCURRENT_PRICING
+    labeling_algorithms_.push_back(std::make_unique<LabelingAlgorithm>(instance, LabelingMode::Beam));
+    labeling_algorithms_.push_back(std::make_unique<LabelingAlgorithm>(instance, LabelingMode::RelaxedDominance));
+    labeling_algorithms_.push_back(std::make_unique<LabelingAlgorithm>(instance, LabelingMode::Sparsified));
+#endif
+}
+
+void PricingPortfolio::set_completion_bounds(const QRouteRelaxation* completion_bounds)
+{
+    for (auto& labeling_algorithm : labeling_algorithms_)
+    {
+        labeling_algorithm->set_completion_bounds(completion_bounds);
+    }
+}
+
+void PricingPortfolio::set_path_filter(const LabelingFilterFunction& path_filter)
+{
+    for (auto& labeling_algorithm : labeling_algorithms_)
+    {
+        labeling_algorithm->set_path_filter(path_filter);
+    }
+}
+
+Size PricingPortfolio::num_rejected_paths() const
+{
+    Size num_rejected_paths = 0;
+    for (const auto& labeling_algorithm : labeling_algorithms_)
+    {
+        num_rejected_paths += labeling_algorithm->num_rejected_paths();
+    }
+    return num_rejected_paths;
+}
+
+void PricingPortfolio::solve(
+    SCIP* scip,                      // SCIP
+    const Bool feasible_master,      // Indicates if the master problem is feasible
+    const LabelingBudget& budget,    // Limits on the effort of each labeling algorithm
+    const Bool warm_start            // Reuse the labels of the previous call if the arcs are unchanged
+)
+{
+    // Clear the output.
+    paths_.clear();
+    spare_paths_.clear();
+
+#ifdef USE_CONCURRENT_PRICING
+    // Create the shared state. Only this thread calls SCIP.
+    std::mutex mutex;
+    std::condition_variable finished_or_found;
+    std::atomic<Bool> stop_exact{false};
+    std::atomic<Bool> stop_heuristics{false};
+    Bool exact_running = true;
+    Size num_heuristics_running = labeling_algorithms_.size() - 1;
+    const auto add_path = [&](Vector<Vertex>&& path, const Cost reduced_cost)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            paths_.push_back({reduced_cost, std::move(path)});
+        }
+        finished_or_found.notify_one();
+    };
+    const auto add_spare_path = [&](Vector<Vertex>&& path, const Cost reduced_cost)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        spare_paths_.push_back({reduced_cost, std::move(path)});
+    };
+
+    // Launch the algorithms.
+    Vector<std::thread> threads;
+    threads.reserve(labeling_algorithms_.size());
+    for (auto& labeling_algorithm : labeling_algorithms_)
+    {
+        threads.emplace_back([&, algorithm = labeling_algorithm.get()]()
+        {
+            const auto is_exact = algorithm->mode() == LabelingMode::Exact;
+            const auto& stop_flag = is_exact ? stop_exact : stop_heuristics;
+            algorithm->solve(reduced_cost_,
+                             feasible_master,
+                             budget,
+                             warm_start,
+                             [&stop_flag]() { return stop_flag.load(std::memory_order_relaxed); },
+                             add_path,
+                             add_spare_path);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (is_exact)
+                {
+                    exact_running = false;
+                }
+                else
+                {
+                    --num_heuristics_running;
+                }
+            }
+            finished_or_found.notify_one();
+        });
+    }
+
+    // Wait until enough paths are found. The heuristics are cancelled once the target is reached or the exact
+    // algorithm finishes. The exact algorithm is only kept running to prove a bound when the heuristics find nothing.
+    {
+        const auto target_num_paths = feasible_master ? budget.max_paths : 1;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (exact_running || num_heuristics_running > 0)
+        {
+            finished_or_found.wait_for(lock, std::chrono::milliseconds(CONCURRENT_PRICING_POLL_INTERVAL));
+
+            const auto num_paths = static_cast<Size>(paths_.size());
+            if (SCIPisStopped(scip) || num_paths >= target_num_paths || !exact_running)
+            {
+                stop_heuristics = true;
+                stop_exact = true;
+            }
+            else if (num_heuristics_running == 0 && num_paths > 0)
+            {
+                stop_exact = true;
+            }
+        }
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // Remove paths found by more than one algorithm.
+    std::sort(paths_.begin(), paths_.end(), [](const PricedPath& a, const PricedPath& b) { return a.path < b.path; });
+    paths_.erase(std::unique(paths_.begin(),
+                             paths_.end(),
+                             [](const PricedPath& a, const PricedPath& b) { return a.path == b.path; }),
+                 paths_.end());
+    debugln("    Concurrent pricing found {} unique paths", paths_.size());
+
+    // Each algorithm has the full budget, so keep the paths with the most negative reduced cost within the budget of
+    // the call and set the others aside.
+    if (feasible_master && static_cast<Size>(paths_.size()) > budget.max_paths)
+    {
+        std::sort(paths_.begin(),
+                  paths_.end(),
+                  [](const PricedPath& a, const PricedPath& b) { return a.reduced_cost < b.reduced_cost; });
+        std::move(paths_.begin() + budget.max_paths, paths_.end(), std::back_inserter(spare_paths_));
+        paths_.resize(budget.max_paths);
+    }
+#else
+    // Run the exact algorithm.
+    auto& labeling_algorithm = *labeling_algorithms_.front();
+    labeling_algorithm.solve(reduced_cost_,
+                             feasible_master,
+                             budget,
+                             warm_start,
+                             [scip]() { return SCIPisStopped(scip); },
+                             [this](Vector<Vertex>&& path, const Cost reduced_cost)
+                             {
+                                 paths_.push_back({reduced_cost, std::move(path)});
+                             },
+                             [this](Vector<Vertex>&& path, const Cost reduced_cost)
+                             {
+                                 spare_paths_.push_back({reduced_cost, std::move(path)});
+                             });
+#endif
+}
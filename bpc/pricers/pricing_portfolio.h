@@ -0,0 +1,52 @@
+#pragma once
+
+#include "labeling/labeling_algorithm.h"
+#include "problem/instance.h"
+#include "problem/scip.h"
+#include "types/basic_types.h"
+#include "types/matrix.h"
+#include "types/pointers.h"
+#include "types/vector.h"
+
+struct PricedPath
+{
+    Cost reduced_cost;
+    Vector<Vertex> path;
+};
+
+// Portfolio of labeling algorithms over the same reduced cost matrix. With USE_CONCURRENT_PRICING, the heuristic
+// algorithms run in parallel with the exact algorithm and the call returns as soon as enough paths are found.
+class PricingPortfolio
+{
+    // Instance
+    Matrix<Cost> reduced_cost_;
+
+    // Solvers, the first of which is exact
+    Vector<UniquePtr<LabelingAlgorithm>> labeling_algorithms_;
+
+    // Output of the last call
+    Vector<PricedPath> paths_;
+    Vector<PricedPath> spare_paths_;
+
+  public:
+    // Constructors and destructor
+    PricingPortfolio(const Instance& instance);
+    PricingPortfolio() = delete;
+    PricingPortfolio(const PricingPortfolio&) = delete;
+    PricingPortfolio(PricingPortfolio&&) = delete;
+    PricingPortfolio& operator=(const PricingPortfolio&) = delete;
+    PricingPortfolio& operator=(PricingPortfolio&&) = delete;
+    ~PricingPortfolio() = default;
+
+    // Solve
+    inline auto& get_reduced_cost_matrix() { return reduced_cost_; }
+    void set_completion_bounds(const QRouteRelaxation* completion_bounds);
+    void set_path_filter(const LabelingFilterFunction& path_filter);
+    void solve(SCIP* scip, const Bool feasible_master, const LabelingBudget& budget, const Bool warm_start);
+
+    // Getters
+    inline auto& paths() { return paths_; }
+    inline auto& spare_paths() { return spare_paths_; }
+    inline const auto& exact_labeling_algorithm() const { return *labeling_algorithms_.front(); }
+    Size num_rejected_paths() const;
+};
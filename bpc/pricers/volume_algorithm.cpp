@@ -0,0 +1,199 @@
+// #define PRINT_DEBUG
+
+#include "pricers/volume_algorithm.h"
+#include "problem/debug.h"
+#include "types/tuple.h"
+#include <algorithm>
+#include <limits>
+
+#ifndef VOLUME_MAX_ITERATIONS
+#define VOLUME_MAX_ITERATIONS (1000)           // Maximum number of iterations
+#endif
+#ifndef VOLUME_ALPHA
+#define VOLUME_ALPHA (0.1)                     // Weight of the newest subproblem solution in the primal estimate
+#endif
+#ifndef VOLUME_INITIAL_STEP_SCALE
+#define VOLUME_INITIAL_STEP_SCALE (0.1)        // Initial scale of the Polyak step size
+#endif
+#ifndef VOLUME_MIN_STEP_SCALE
+#define VOLUME_MIN_STEP_SCALE (1e-4)           // Stop once the scale of the step size falls below this
+#endif
+#ifndef VOLUME_NUM_NON_IMPROVING
+#define VOLUME_NUM_NON_IMPROVING (20)          // Shrink the step size after this many iterations without improvement
+#endif
+#ifndef VOLUME_MAX_NUM_PATHS
+#define VOLUME_MAX_NUM_PATHS (1000)            // Maximum number of paths to output
+#endif
+#ifndef VOLUME_PATH_BUFFER_FACTOR
+#define VOLUME_PATH_BUFFER_FACTOR (4)          // Rank and truncate the paths once this many times the output are stored
+#endif
+
+VolumeAlgorithm::VolumeAlgorithm(const Instance& instance) :
+    instance_(instance),
+    q_route_(instance),
+    reduced_cost_(instance.num_vertices(), instance.num_vertices()),
+    duals_(instance.num_customers()),
+    bound_(-std::numeric_limits<Float>::infinity()),
+    paths_()
+{
+}
+
+Float VolumeAlgorithm::evaluate(const Size fleet_bound, const Vector<Cost>& duals, Vector<Float>& primal)
+{
+    // Get instance.
+    const auto num_customers = instance_.num_customers();
+    const auto num_vertices = instance_.num_vertices();
+
+    // Create the reduced cost matrix.
+    for (Vertex i = 0; i < num_vertices; ++i)
+    {
+        const auto dual = i < num_customers ? duals[i] : 0.0;
+        for (Vertex j = 0; j < num_vertices; ++j)
+        {
+            reduced_cost_(i, j) = instance_.cost(i, j) - dual;
+        }
+    }
+
+    // Solve the subproblem. The paths are ranked and truncated whenever the buffer is full.
+    q_route_.solve(reduced_cost_, [this](Vector<Vertex>&& path, const Cost)
+    {
+        paths_.push_back(std::move(path));
+    });
+    debug_assert(q_route_.solved());
+    if (static_cast<Size>(paths_.size()) >= VOLUME_PATH_BUFFER_FACTOR * VOLUME_MAX_NUM_PATHS)
+    {
+        select_paths();
+    }
+
+    // Use the cheapest path as many times as possible if it has negative reduced cost.
+    std::fill(primal.begin(), primal.end(), 0.0);
+    const auto& best_path = q_route_.best_path();
+    for (Size idx = 1; idx < static_cast<Size>(best_path.size()) - 1; ++idx)
+    {
+        primal[best_path[idx]] += fleet_bound;
+    }
+
+    // Compute the Lagrangian bound.
+    Float bound = fleet_bound * std::min(q_route_.obj(), 0.0);
+    for (Vertex i = 0; i < num_customers; ++i)
+    {
+        bound += duals[i];
+    }
+    return bound;
+}
+
+void VolumeAlgorithm::solve(
+    const Size fleet_bound,     // Maximum number of paths in the Lagrangian subproblem
+    const Float upper_bound     // Objective value of a feasible solution used to size the steps
+)
+{
+    // Get instance.
+    const auto num_customers = instance_.num_customers();
+
+    // Clear the output.
+    std::fill(duals_.begin(), duals_.end(), 0.0);
+    bound_ = -std::numeric_limits<Float>::infinity();
+    paths_.clear();
+    if (!q_route_.enabled())
+    {
+        return;
+    }
+
+    // Start from zero multipliers.
+    Vector<Cost> duals(num_customers, 0.0);
+    Vector<Float> primal(num_customers);
+    Vector<Float> primal_estimate(num_customers);
+    bound_ = evaluate(fleet_bound, duals_, primal_estimate);
+
+    // Move the multipliers along the violation of the primal estimate and move the center to the new multipliers if
+    // they improve the bound.
+    Float step_scale = VOLUME_INITIAL_STEP_SCALE;
+    Size num_non_improving = 0;
+    Size iter = 0;
+    for (; iter < VOLUME_MAX_ITERATIONS && step_scale >= VOLUME_MIN_STEP_SCALE; ++iter)
+    {
+        // Compute the step.
+        Float norm = 0.0;
+        for (Vertex i = 0; i < num_customers; ++i)
+        {
+            const auto violation = 1.0 - primal_estimate[i];
+            norm += violation * violation;
+        }
+        if (norm <= 0.0 || upper_bound <= bound_)
+        {
+            break;
+        }
+        const auto step = step_scale * (upper_bound - bound_) / norm;
+        for (Vertex i = 0; i < num_customers; ++i)
+        {
+            duals[i] = duals_[i] + step * (1.0 - primal_estimate[i]);
+#ifdef USE_SET_COVERING
+            duals[i] = std::max(duals[i], 0.0);
+#endif
+        }
+
+        // Solve the subproblem.
+        const auto bound = evaluate(fleet_bound, duals, primal);
+
+        // Update the primal estimate.
+        for (Vertex i = 0; i < num_customers; ++i)
+        {
+            primal_estimate[i] = VOLUME_ALPHA * primal[i] + (1.0 - VOLUME_ALPHA) * primal_estimate[i];
+        }
+
+        // Move the center.
+        if (bound > bound_)
+        {
+            duals_ = duals;
+            bound_ = bound;
+            num_non_improving = 0;
+        }
+        else if (++num_non_improving >= VOLUME_NUM_NON_IMPROVING)
+        {
+            step_scale *= 0.5;
+            num_non_improving = 0;
+        }
+    }
+
+    // Keep the best paths under the final multipliers.
+    select_paths();
+    debugln("Volume algorithm found bound {} and {} paths in {} iterations", bound_, paths_.size(), iter);
+}
+
+void VolumeAlgorithm::select_paths()
+{
+    // Remove duplicate paths.
+    std::sort(paths_.begin(), paths_.end());
+    paths_.erase(std::unique(paths_.begin(), paths_.end()), paths_.end());
+    if (static_cast<Size>(paths_.size()) <= VOLUME_MAX_NUM_PATHS)
+    {
+        return;
+    }
+
+    // Rank the paths by their reduced cost under the best multipliers.
+    Vector<Pair<Cost, Size>> ranks(paths_.size());
+    for (Size p = 0; p < static_cast<Size>(paths_.size()); ++p)
+    {
+        const auto& path = paths_[p];
+        Cost path_reduced_cost = 0.0;
+        for (Size idx = 0; idx < static_cast<Size>(path.size()) - 1; ++idx)
+        {
+            path_reduced_cost += instance_.cost(path[idx], path[idx + 1]);
+        }
+        for (Size idx = 1; idx < static_cast<Size>(path.size()) - 1; ++idx)
+        {
+            path_reduced_cost -= duals_[path[idx]];
+        }
+        ranks[p] = {path_reduced_cost, p};
+    }
+    std::nth_element(ranks.begin(), ranks.begin() + VOLUME_MAX_NUM_PATHS, ranks.end());
+
+    // Keep the best paths.
+    Vector<Vector<Vertex>> paths;
+    paths.reserve(VOLUME_MAX_NUM_PATHS);
+    for (Size k = 0; k < VOLUME_MAX_NUM_PATHS; ++k)
+    {
+        paths.push_back(std::move(paths_[ranks[k].second]));
+    }
+    paths_ = std::move(paths);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "labeling/q_route_relaxation.h"
+#include "problem/instance.h"
+#include "types/basic_types.h"
+#include "types/matrix.h"
+#include "types/vector.h"
+
+// Volume algorithm for the Lagrangian dual of the customer cover constraints with at most a given number of paths.
+// The Lagrangian subproblem is solved using the q-route relaxation. The multipliers with the best bound approximate
+// the optimal duals of the master problem at the root node and the elementary paths found along the way are good
+// initial columns.
+class VolumeAlgorithm
+{
+    // Instance
+    const Instance& instance_;
+    QRouteRelaxation q_route_;
+    Matrix<Cost> reduced_cost_;
+
+    // Output
+    Vector<Cost> duals_;
+    Float bound_;
+    Vector<Vector<Vertex>> paths_;
+
+  public:
+    // Constructors and destructor
+    VolumeAlgorithm(const Instance& instance);
+    VolumeAlgorithm() = delete;
+    VolumeAlgorithm(const VolumeAlgorithm&) = delete;
+    VolumeAlgorithm(VolumeAlgorithm&&) = delete;
+    VolumeAlgorithm& operator=(const VolumeAlgorithm&) = delete;
+    VolumeAlgorithm& operator=(VolumeAlgorithm&&) = delete;
+    ~VolumeAlgorithm() = default;
+
+    // Solve
+    void solve(
+        const Size fleet_bound,     // Maximum number of paths in the Lagrangian subproblem
+        const Float upper_bound     // Objective value of a feasible solution used to size the steps
+    );
+
+    // Getters
+    inline auto enabled() const { return q_route_.enabled(); }
+    inline const auto& duals() const { return duals_; }
+    inline auto bound() const { return bound_; }
+    inline auto& paths() { return paths_; }
+
+  private:
+    // Evaluate the Lagrangian function and its primal solution at some multipliers
+    Float evaluate(const Size fleet_bound, const Vector<Cost>& duals, Vector<Float>& primal);
+
+    // Keep the unique paths with the most negative reduced cost under the best multipliers
+    void select_paths();
+};
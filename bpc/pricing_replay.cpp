@@ -0,0 +1,184 @@
+#include "labeling/labeling_algorithm.h"
+#include "labeling/pricing_capture.h"
+#include "labeling/q_route_relaxation.h"
+#include "problem/debug.h"
+#include "problem/instance.h"
+#include "types/basic_types.h"
+#include "types/matrix.h"
+#include "types/string.h"
+#include "types/vector.h"
+#include <chrono>
+#include <cmath>
+#include <cxxopts.hpp>
+
+// Parse the name of a labeling mode
+static LabelingMode parse_mode(const String& name)
+{
+    if (name == "exact")
+    {
+        return LabelingMode::Exact;
+    }
+    else if (name == "beam")
+    {
+        return LabelingMode::Beam;
+    }
+    else if (name == "relaxed")
+    {
+        return LabelingMode::RelaxedDominance;
+    }
+    else if (name == "sparsified")
+    {
+        return LabelingMode::Sparsified;
+    }
+    err("Unknown labeling mode {}", name);
+}
+
+int main(int argc, char** argv)
+{
+    // Parse program options.
+    String instance_path;
+    String capture_path;
+    LabelingMode mode = LabelingMode::Exact;
+    Bool use_q_route = false;
+    Bool warm_start = false;
+    Size num_repeats = 1;
+    try
+    {
+        // Create program options.
+        cxxopts::Options options(argv[0], "Replay captured pricing problems of BPC-VRPTW");
+        options.positional_help("instance_path capture_path").show_positional_help();
+        options.add_options()
+            ("help", "Print help")
+            ("i,instance", "Path to instance file", cxxopts::value<String>())
+            ("c,capture", "Path to pricing capture file", cxxopts::value<String>())
+            ("m,mode", "Labeling mode (exact, beam, relaxed, sparsified)", cxxopts::value<String>())
+            ("q,q-route", "Prune labels using the completion bounds of the q-route relaxation")
+            ("w,warm-start", "Reuse the labels of the previous pricing problem if it has the same arcs")
+            ("r,repeats", "Number of times to solve each pricing problem", cxxopts::value<Size>())
+        ;
+        options.parse_positional({"instance", "capture"});
+
+        // Parse options.
+        auto result = options.parse(argc, argv);
+
+        // Print help.
+        if (result.count("help") || !result.count("instance") || !result.count("capture"))
+        {
+            println("{}", options.help());
+            exit(0);
+        }
+
+        // Get options.
+        instance_path = result["instance"].as<String>();
+        capture_path = result["capture"].as<String>();
+        if (result.count("mode"))
+        {
+            mode = parse_mode(result["mode"].as<String>());
+        }
+        use_q_route = result.count("q-route");
+        warm_start = result.count("warm-start");
+        if (result.count("repeats"))
+        {
+            num_repeats = std::max<Size>(result["repeats"].as<Size>(), 1);
+        }
+
+        // A repeat would warm start from the labels of the previous repeat, which already solved the same problem,
+        // instead of from the labels of the previous pricing problem.
+        if (warm_start && num_repeats > 1)
+        {
+            err("Warm start cannot be combined with repeats");
+        }
+    }
+    catch (const cxxopts::exceptions::exception& e)
+    {
+        err("{}", e.what());
+    }
+
+    // Load instance.
+    const Instance instance(instance_path);
+    const auto num_vertices = instance.num_vertices();
+
+    // Create solvers.
+    LabelingAlgorithm labeling_algorithm(instance, mode);
+    QRouteRelaxation q_route(instance);
+    if (use_q_route)
+    {
+        labeling_algorithm.set_completion_bounds(&q_route);
+    }
+
+    // Solve every pricing problem in the capture file.
+    PricingCaptureReader reader(capture_path, instance);
+    Matrix<Cost> reduced_cost(num_vertices, num_vertices);
+    Vector<Bool> enabled_arcs(num_vertices * num_vertices);
+    Bool feasible_master = false;
+    LabelingBudget budget{};
+    Size num_calls = 0;
+    Size total_num_paths = 0;
+    Size total_num_iterations = 0;
+    Size total_num_labels = 0;
+    Float total_run_time = 0.0;
+    println("{:>6s} {:>8s} {:>8s} {:>12s} {:>9s} {:>12s} {:>12s} {:>10s}",
+            "Call", "Feasible", "Paths", "Obj", "Completed", "Iterations", "Labels", "Time (ms)");
+    while (reader.read(reduced_cost, feasible_master, budget))
+    {
+        // Only warm start from the labels of the previous pricing problem if no arc was disabled or enabled since,
+        // as the stored labels can extend along arcs that are now disabled.
+        Bool same_arcs = num_calls > 0;
+        for (Vertex i = 0; i < num_vertices; ++i)
+            for (Vertex j = 0; j < num_vertices; ++j)
+            {
+                const Bool enabled = !std::isnan(reduced_cost(i, j));
+                same_arcs &= enabled_arcs[i * num_vertices + j] == enabled;
+                enabled_arcs[i * num_vertices + j] = enabled;
+            }
+
+        Size num_paths = 0;
+        Float run_time = 0.0;
+        for (Size repeat = 0; repeat < num_repeats; ++repeat)
+        {
+            num_paths = 0;
+            const auto start_time = std::chrono::steady_clock::now();
+            if (use_q_route)
+            {
+                q_route.solve(reduced_cost, [](Vector<Vertex>&&, const Cost) {});
+            }
+            labeling_algorithm.solve(reduced_cost,
+                                     feasible_master,
+                                     budget,
+                                     warm_start && same_arcs,
+                                     []() { return false; },
+                                     [&num_paths](Vector<Vertex>&&, const Cost) { ++num_paths; },
+                                     [](Vector<Vertex>&&, const Cost) {});
+            const auto end_time = std::chrono::steady_clock::now();
+            run_time += std::chrono::duration<Float, std::milli>(end_time - start_time).count();
+        }
+        run_time /= num_repeats;
+
+        // Print.
+        println("{:>6d} {:>8d} {:>8d} {:>12.4f} {:>9d} {:>12d} {:>12d} {:>10.3f}",
+                num_calls,
+                feasible_master,
+                num_paths,
+                labeling_algorithm.obj(),
+                labeling_algorithm.completed(),
+                labeling_algorithm.num_iterations(),
+                labeling_algorithm.num_labels(),
+                run_time);
+
+        // Store statistics.
+        ++num_calls;
+        total_num_paths += num_paths;
+        total_num_iterations += labeling_algorithm.num_iterations();
+        total_num_labels += labeling_algorithm.num_labels();
+        total_run_time += run_time;
+    }
+
+    // Print statistics.
+    println("");
+    println("Pricing problems: {}", num_calls);
+    println("Paths: {}", total_num_paths);
+    println("Iterations: {}", total_num_iterations);
+    println("Labels: {}", total_num_labels);
+    println("Run time: {:.3f} ms", total_run_time);
+    return 0;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "problem/debug.h"
+#include "problem/scip.h"
+#include "types/basic_types.h"
+#include "types/edge.h"
+#include "types/matrix.h"
+#include "types/span.h"
+#include "types/vector.h"
+
+// Total value and number of paths using each edge in a solution of the master problem, stored densely. The edges
+// used by any path are listed so that the totals can be reset without clearing the whole matrix, and the edges with
+// fractional total value are listed as branching candidates.
+class FractionalEdges
+{
+    Matrix<SCIP_Real> val_;    // Total value of the paths using each edge
+    Matrix<Size> count_;       // Number of paths with fractional value using each edge
+    Vector<Edge> touched_;     // Edges with a non-zero total
+    Vector<Edge> edges_;       // Edges with fractional total value
+
+  public:
+    // Constructors and destructor
+    FractionalEdges(const Size num_vertices) :
+        val_(num_vertices, num_vertices, 0.0),
+        count_(num_vertices, num_vertices, 0),
+        touched_(),
+        edges_()
+    {}
+    FractionalEdges() = delete;
+    FractionalEdges(const FractionalEdges&) = default;
+    FractionalEdges(FractionalEdges&&) = delete;
+    FractionalEdges& operator=(const FractionalEdges&) = delete;
+    FractionalEdges& operator=(FractionalEdges&&) = delete;
+    ~FractionalEdges() = default;
+
+    // Getters
+    inline auto empty() const { return edges_.empty(); }
+    inline const auto& edges() const { return edges_; }
+    inline auto val(const Edge edge) const { return val_(edge.i, edge.j); }
+    inline auto count(const Edge edge) const { return count_(edge.i, edge.j); }
+    inline Bool contains(const Edge edge) const { return count_(edge.i, edge.j) > 0; }
+
+    // Reset the totals of the edges used previously
+    void clear()
+    {
+        for (const auto edge : touched_)
+        {
+            val_(edge.i, edge.j) = 0.0;
+            count_(edge.i, edge.j) = 0;
+        }
+        touched_.clear();
+        edges_.clear();
+    }
+
+    // Add the edges of a path with fractional value
+    void add(const Span<const Vertex> path, const SCIP_Real val)
+    {
+        for (Size idx = 0; idx < path.size() - 1; ++idx)
+        {
+            const Edge edge{path[idx], path[idx + 1]};
+            auto& edge_count = count_(edge.i, edge.j);
+            if (edge_count == 0)
+            {
+                touched_.push_back(edge);
+            }
+            val_(edge.i, edge.j) += val;
+            ++edge_count;
+        }
+    }
+
+    // List the edges with fractional total value and zero the totals of the other edges
+    void finish(SCIP* scip)
+    {
+        debug_assert(edges_.empty());
+        for (const auto edge : touched_)
+        {
+            auto& edge_val = val_(edge.i, edge.j);
+            if (SCIPisIntegral(scip, edge_val))
+            {
+                edge_val = 0.0;
+                count_(edge.i, edge.j) = 0;
+            }
+            else
+            {
+                edges_.push_back(edge);
+            }
+        }
+    }
+};
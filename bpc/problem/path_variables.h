@@ -0,0 +1,226 @@
+#pragma once
+
+#include "problem/debug.h"
+#include "problem/scip.h"
+#include "types/basic_types.h"
+#include "types/bitset.h"
+#include "types/hash_map.h"
+#include "types/span.h"
+#include "types/vector.h"
+#include <algorithm>
+
+// Data of one path variable
+struct PathVariable
+{
+    SCIP_Var* var;              // Variable
+    SCIP_Real val;              // Value of the variable in the current LP solution
+    Span<const Vertex> path;    // Path, including the depot at both ends
+};
+
+// Path variables stored in parallel arrays. The paths are stored as the vertices of each path in compressed sparse
+// rows so that scans over the variables stream through memory instead of following a pointer per path. The paths are
+// also indexed by their hash to find duplicates, with the paths of a colliding hash chained through an array, and the
+// variables are indexed by the arcs and customers they use so that branching decisions only visit the variables they
+// affect. The inverted indices list the variables in increasing order. Each variable also has a bitmask of its
+// customers and a signature of its arcs, with one bit per hashed arc, for checking a path against an arc without
+// walking it.
+class PathVariables
+{
+    Vector<SCIP_Var*> vars_;                 // Variable of each path
+    Vector<SCIP_Real> vals_;                 // Value of each variable in the current LP solution
+    Vector<Vertex> vertices_;                // Vertices of all paths, including the depot at both ends
+    Vector<Size> offsets_;                   // Index of the first vertex of each path, plus the end of the last path
+    HashMap<UInt64, Size> index_;            // Last indexed variable with each hash
+    Vector<Size> next_in_index_;             // Previous indexed variable with the same hash, or -1
+    Size num_vertices_;                      // Number of vertices in the instance
+    Vector<Vector<Size>> arc_vars_;          // Variables whose path uses each arc
+    Vector<Vector<Size>> customer_vars_;     // Variables whose path visits each customer
+    Size customer_mask_size_;                // Number of bytes in the bitmask of customers of a variable
+    Vector<Byte> customer_masks_;            // Customers visited by each variable
+    Vector<UInt64> arc_signatures_;          // Hashed arcs used by each variable
+
+  public:
+    class ConstIterator
+    {
+        const PathVariables* vars_;
+        Size v_;
+
+      public:
+        ConstIterator(const PathVariables* vars, const Size v) : vars_(vars), v_(v) {}
+        inline PathVariable operator*() const { return (*vars_)[v_]; }
+        inline ConstIterator& operator++() { ++v_; return *this; }
+        inline Bool operator!=(const ConstIterator& other) const { return v_ != other.v_; }
+    };
+
+    // Constructors and destructor
+    PathVariables(const Size num_vertices) :
+        vars_(),
+        vals_(),
+        vertices_(),
+        offsets_(1, 0),
+        index_(),
+        next_in_index_(),
+        num_vertices_(num_vertices),
+        arc_vars_(num_vertices * num_vertices),
+        customer_vars_(num_vertices),
+        customer_mask_size_((num_vertices + CHAR_BIT - 1) / CHAR_BIT),
+        customer_masks_(),
+        arc_signatures_()
+    {}
+    PathVariables() = delete;
+    PathVariables(const PathVariables&) = default;
+    PathVariables(PathVariables&&) = delete;
+    PathVariables& operator=(const PathVariables&) = delete;
+    PathVariables& operator=(PathVariables&&) = delete;
+    ~PathVariables() = default;
+
+    // Getters
+    inline auto size() const { return static_cast<Size>(vars_.size()); }
+    inline auto empty() const { return vars_.empty(); }
+    inline SCIP_Var* var(const Size v) const { debug_assert(0 <= v && v < size()); return vars_[v]; }
+    inline SCIP_Var*& var(const Size v) { debug_assert(0 <= v && v < size()); return vars_[v]; }
+    inline SCIP_Real val(const Size v) const { debug_assert(0 <= v && v < size()); return vals_[v]; }
+    inline SCIP_Real& val(const Size v) { debug_assert(0 <= v && v < size()); return vals_[v]; }
+    inline Span<const Vertex> path(const Size v) const
+    {
+        debug_assert(0 <= v && v < size());
+        return {vertices_.data() + offsets_[v], offsets_[v + 1] - offsets_[v]};
+    }
+    inline PathVariable operator[](const Size v) const { return {var(v), val(v), path(v)}; }
+    inline const auto& arc_vars(const Vertex i, const Vertex j) const { return arc_vars_[i * num_vertices_ + j]; }
+    inline const auto& customer_vars(const Vertex i) const { return customer_vars_[i]; }
+    inline Bool visits(const Size v, const Vertex i) const
+    {
+        debug_assert(0 <= v && v < size());
+        return get_bitset(customer_masks_.data() + v * customer_mask_size_, i);
+    }
+    inline Bool may_use_arc(const Size v, const Vertex i, const Vertex j) const
+    {
+        debug_assert(0 <= v && v < size());
+        return (arc_signatures_[v] & arc_signature(i, j)) != 0;
+    }
+
+    // Iterators
+    inline ConstIterator begin() const { return {this, 0}; }
+    inline ConstIterator end() const { return {this, size()}; }
+
+    // Modify
+    void reserve(const Size num_vars, const Size num_vertices)
+    {
+        vars_.reserve(num_vars);
+        vals_.reserve(num_vars);
+        offsets_.reserve(num_vars + 1);
+        vertices_.reserve(num_vertices);
+        index_.reserve(num_vars);
+        next_in_index_.reserve(num_vars);
+        customer_masks_.reserve(num_vars * customer_mask_size_);
+        arc_signatures_.reserve(num_vars);
+    }
+    Size add(SCIP_Var* var, const Span<const Vertex> path)
+    {
+        const auto v = size();
+        vars_.push_back(var);
+        vals_.push_back(0.0);
+        vertices_.insert(vertices_.end(), path.begin(), path.end());
+        offsets_.push_back(static_cast<Size>(vertices_.size()));
+        auto& next = next_in_index_.emplace_back(-1);
+        if (auto [it, inserted] = index_.try_emplace(hash(path), v); !inserted)
+        {
+            next = it->second;
+            it->second = v;
+        }
+
+        // Index the arcs and the customers of the path and make the signatures.
+        customer_masks_.resize(customer_masks_.size() + customer_mask_size_, 0);
+        const auto customer_mask = customer_masks_.data() + v * customer_mask_size_;
+        auto& signature = arc_signatures_.emplace_back(0);
+        for (Size idx = 0; idx < path.size() - 1; ++idx)
+        {
+            const auto i = path[idx];
+            const auto j = path[idx + 1];
+            signature |= arc_signature(i, j);
+            auto& arc_vars = arc_vars_[i * num_vertices_ + j];
+            if (arc_vars.empty() || arc_vars.back() != v)
+            {
+                arc_vars.push_back(v);
+            }
+            if (idx > 0)
+            {
+                auto& customer_vars = customer_vars_[i];
+                if (customer_vars.empty() || customer_vars.back() != v)
+                {
+                    customer_vars.push_back(v);
+                }
+                set_bitset(customer_mask, i);
+            }
+        }
+        return v;
+    }
+
+    // Get the variable of a path that has not been removed from the index, or -1 if there is none
+    Size find(const Span<const Vertex> path) const
+    {
+        const auto it = index_.find(hash(path));
+        if (it == index_.end())
+        {
+            return -1;
+        }
+        for (auto v = it->second; v >= 0; v = next_in_index_[v])
+        {
+            const auto other = this->path(v);
+            if (std::equal(path.begin(), path.end(), other.begin(), other.end()))
+            {
+                return v;
+            }
+        }
+        return -1;
+    }
+
+    // Check if a path belongs to a variable that has not been removed from the index
+    inline Bool contains(const Span<const Vertex> path) const { return find(path) >= 0; }
+
+    // Remove the path of a variable from the index so that the path can be added again
+    void remove_from_index(const Size v)
+    {
+        const auto it = index_.find(hash(path(v)));
+        if (it == index_.end())
+        {
+            return;
+        }
+        if (it->second == v)
+        {
+            if (next_in_index_[v] >= 0)
+            {
+                it->second = next_in_index_[v];
+            }
+            else
+            {
+                index_.erase(it);
+            }
+        }
+        else
+        {
+            auto u = it->second;
+            while (u >= 0 && next_in_index_[u] != v)
+            {
+                u = next_in_index_[u];
+            }
+            if (u < 0)
+            {
+                return;
+            }
+            next_in_index_[u] = next_in_index_[v];
+        }
+        next_in_index_[v] = -1;
+    }
+
+  private:
+    inline UInt64 arc_signature(const Vertex i, const Vertex j) const
+    {
+        return UInt64{1} << (((i * num_vertices_ + j) * UInt64{0x9E3779B97F4A7C15}) >> 58);
+    }
+    static inline UInt64 hash(const Span<const Vertex> path)
+    {
+        return ankerl::unordered_dense::detail::wyhash::hash(path.data(), path.size() * sizeof(Vertex));
+    }
+};
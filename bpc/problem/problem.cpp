@@ -9,11 +9,20 @@
 // #include "types/hash_map.h"
 #include "branching/constraint_handler_edge_branching.h"
 #include "branching/edge_branching.h"
+#include "heuristics/heuristic_repair.h"
 #include "output/formatting.h"
 #include "pricers/pricer_labeling.h"
 #include "problem/problem.h"
 #include "problem/scip.h"
+#include "propagators/propagator_reduced_cost.h"
 #include <scip/cons_linear.h>
+#include <algorithm>
+#include <limits>
+
+// The surplus variables of the dual-optimal inequalities are redundant in a set covering master problem
+#if defined(USE_SET_COVERING) && defined(USE_DUAL_OPTIMAL_INEQUALITIES)
+#error "USE_SET_COVERING and USE_DUAL_OPTIMAL_INEQUALITIES cannot be used together"
+#endif
 
 // Create problem data for transformed problem
 static SCIP_DECL_PROBTRANS(prob_trans)
@@ -74,8 +83,23 @@ static SCIP_DECL_PROBDELTRANS(prob_deltrans)
 // Create a problem
 Problem::Problem(SCIP* scip, const SharedPtr<Instance>& instance) :
     instance(instance),
-    vars(),
-    fractional_edges(),
+    vars(instance->num_vertices()),
+    num_duplicate_paths(0),
+    num_deleted_vars(0),
+#ifdef USE_DUAL_OPTIMAL_INEQUALITIES
+    customer_surplus_vars(instance->num_customers()),
+#endif
+    fractional_edges(instance->num_vertices()),
+    node_warm_starts(),
+#ifdef USE_REDUCED_COST_FIXING
+    fixing_duals(instance->num_customers()),
+    fixing_bound(0.0),
+    fixing_node(-1),
+#endif
+    path_customers_buffer(),
+#if defined(USE_SET_COVERING) || defined(USE_DUAL_OPTIMAL_INEQUALITIES)
+    repaired_sol_index(-1),
+#endif
     customer_cover_conss(instance->num_customers()),
     edge_branching_conshdlr(nullptr)
 {
@@ -91,7 +115,14 @@ Problem::Problem(SCIP* scip, const SharedPtr<Instance>& instance) :
     // Tell SCIP that the objective value will be always integral.
     scip_assert(SCIPsetObjIntegral(scip));
 
-    // Create the customer cover constraints.
+    // Create the customer cover constraints. In the set covering formulation, a customer can be covered more than
+    // once. Removing it from all but one path is feasible and does not increase the cost by the triangle inequality,
+    // so the optimal value is the same and the duals are non-negative.
+#ifdef USE_SET_COVERING
+    const auto cover_rhs = SCIPinfinity(scip);
+#else
+    const auto cover_rhs = 1.0;
+#endif
     const auto num_customers = instance->num_customers();
     for (Vertex i = 0; i < num_customers; ++i)
     {
@@ -105,7 +136,7 @@ Problem::Problem(SCIP* scip, const SharedPtr<Instance>& instance) :
                                          nullptr,
                                          nullptr,
                                          1.0,
-                                         1.0,
+                                         cover_rhs,
                                          true,
                                          true,
                                          true,
@@ -122,6 +153,59 @@ Problem::Problem(SCIP* scip, const SharedPtr<Instance>& instance) :
         scip_assert(SCIPaddCons(scip, cons));
     }
 
+    // Create surplus variables for the customer cover constraints. If a customer is covered more than once, it can be
+    // removed from all but one path. Removing customer i from between j and k is feasible by the triangle inequality
+    // and saves at least the smallest detour c(j,i) + c(i,k) - c(j,k). Allowing over-covering at a profit of this
+    // amount does not change the optimal value but imposes the dual-optimal inequality that the dual of the customer
+    // cover constraint of i is at least this amount, which reduces dual degeneracy.
+#ifdef USE_DUAL_OPTIMAL_INEQUALITIES
+    {
+        const auto depot = instance->depot();
+        const auto num_vertices = instance->num_vertices();
+        for (Vertex i = 0; i < num_customers; ++i)
+        {
+            // Calculate the smallest detour over all pairs of neighbours that can appear around i in a path.
+            auto min_detour = std::numeric_limits<Cost>::infinity();
+            for (Vertex j = 0; j < num_vertices; ++j)
+                if (instance->is_valid(j, i))
+                    for (Vertex k = 0; k < num_vertices; ++k)
+                        if (instance->is_valid(i, k))
+                        {
+                            if (j == depot && k == depot)
+                            {
+                                min_detour = std::min(min_detour, instance->cost(j, i) + instance->cost(i, k));
+                            }
+                            else if (instance->is_valid(j, k))
+                            {
+                                min_detour = std::min(min_detour,
+                                                      instance->cost(j, i) + instance->cost(i, k) -
+                                                      instance->cost(j, k));
+                            }
+                        }
+            debug_assert(min_detour >= 0.0);
+            if (std::isinf(min_detour))
+            {
+                continue;
+            }
+
+            // Create variable.
+            const auto name = fmt::format("customer_surplus({})", instance->vertex_name[i]);
+            auto& var = customer_surplus_vars[i];
+            scip_assert(SCIPcreateVarBasic(scip,
+                                           &var,
+                                           name.c_str(),
+                                           0.0,
+                                           SCIPinfinity(scip),
+                                           -min_detour,
+                                           SCIP_VARTYPE_CONTINUOUS));
+            debug_assert(var);
+            scip_assert(SCIPaddVar(scip, var));
+            scip_assert(SCIPaddCoefLinear(scip, customer_cover_conss[i], var, -1.0));
+            debugln("Adding dual-optimal inequality with detour {} for customer {}", min_detour, i);
+        }
+    }
+#endif
+
     // Include separator for rounded capacity cuts.
 // #ifdef USE_ROUNDED_CAPACITY_CUTS
 //     cvrpsep = std::make_shared<CVRPSEP>(*instance);
@@ -148,9 +232,19 @@ Problem::Problem(SCIP* scip, const SharedPtr<Instance>& instance) :
     // Create the labeling pricer.
     scip_assert(SCIPincludePricerLabeling(scip, *instance));
 
+    // Include the propagator for reduced cost fixing.
+#ifdef USE_REDUCED_COST_FIXING
+    scip_assert(SCIPincludePropReducedCost(scip));
+#endif
+
+    // Include the heuristic repairing over-covered incumbents.
+#if defined(USE_SET_COVERING) || defined(USE_DUAL_OPTIMAL_INEQUALITIES)
+    scip_assert(SCIPincludeHeurRepairCovering(scip));
+#endif
+
     // Include the edge branching rule.
     scip_assert(SCIPincludeEdgeBranchrule(scip));
-    scip_assert(SCIPincludeConshdlrEdgeBranching(scip));
+    scip_assert(SCIPincludeConshdlrEdgeBranching(scip, *instance));
     edge_branching_conshdlr = SCIPfindConshdlr(scip, "edge_branching");
     release_assert(edge_branching_conshdlr, "Constraint handler for edge branching is missing");
 }
@@ -185,7 +279,7 @@ Problem* Problem::transform(SCIP* scip) const
 
     // Allocate memory for variables.
     release_assert(transformed_problem->vars.empty(), "Original problem already has variables");
-    transformed_problem->vars.reserve(10000);
+    transformed_problem->vars.reserve(10000, 100000);
 
     // Transform customer cover constraints.
     scip_assert(SCIPtransformConss(scip,
@@ -193,6 +287,17 @@ Problem* Problem::transform(SCIP* scip) const
                                    transformed_problem->customer_cover_conss.data(),
                                    transformed_problem->customer_cover_conss.data()));
 
+    // Transform surplus variables.
+#ifdef USE_DUAL_OPTIMAL_INEQUALITIES
+    for (auto& var : transformed_problem->customer_surplus_vars)
+        if (var)
+        {
+            scip_assert(SCIPgetTransformedVar(scip, var, &var));
+            debug_assert(var);
+            scip_assert(SCIPcaptureVar(scip, var));
+        }
+#endif
+
     // Transform robust cuts.
 //     transformed_problem->robust_cuts.clear();
 //     transformed_problem->robust_cuts.reserve(5000);
@@ -250,11 +355,20 @@ void Problem::finish_solve(SCIP* scip)
 void Problem::free(SCIP* scip)
 {
     // Free variables.
-    for (auto& [var, _, __] : vars)
+    for (Size v = 0; v < vars.size(); ++v)
     {
-        scip_assert(SCIPreleaseVar(scip, &var));
+        scip_assert(SCIPreleaseVar(scip, &vars.var(v)));
     }
 
+    // Free surplus variables.
+#ifdef USE_DUAL_OPTIMAL_INEQUALITIES
+    for (auto& var : customer_surplus_vars)
+        if (var)
+        {
+            scip_assert(SCIPreleaseVar(scip, &var));
+        }
+#endif
+
     // Free customer cover constraints.
     for (auto& cons : customer_cover_conss)
     {
@@ -281,7 +395,7 @@ void Problem::free(SCIP* scip)
 }
 
 // Add a variable in pricing
-void Problem::add_priced_var(SCIP* scip, Vector<Vertex>&& path_input)
+Bool Problem::add_priced_var(SCIP* scip, Vector<Vertex>&& path_input)
 {
     // Check.
     debug_assert(scip);
@@ -289,44 +403,24 @@ void Problem::add_priced_var(SCIP* scip, Vector<Vertex>&& path_input)
     debug_assert(path_input.front() == instance->depot());
     debug_assert(path_input.back() == instance->depot());
 
-    // Check that the path satisifies the branching decisions
-#ifdef DEBUG
+    // Skip the path if it already exists. A path is only generated again if its variable is fixed to zero in the
+    // node, for example by reduced cost fixing, since the arcs of a path forbidden by branching are disabled in
+    // pricing and the reduced cost of a variable that is free in the LP is not negative.
+    if (const auto v = vars.find(path_input); v >= 0)
     {
-        auto edge_branching_conss = SCIPconshdlrGetConss(edge_branching_conshdlr);
-        const auto num_edge_branching_conss = SCIPconshdlrGetNConss(edge_branching_conshdlr);
-        for (Size idx = 0; idx < num_edge_branching_conss; ++idx)
-        {
-            // Get the constraint.
-            auto cons = edge_branching_conss[idx];
-            debug_assert(cons);
-
-            // Ignore constraints that are not active since these are not on the current active path of the search tree.
-            if (!SCIPconsIsActive(cons))
-            {
-                continue;
-            }
-
-            // Check the decision.
-            const auto [edge, dir] = SCIPgetEdgeBranchingDecision(cons);
-            release_assert(!edge_branching_check_disable_path(edge, dir, path_input),
-                           "Adding path {} that does not satisfy branching decision {} ({},{})",
-                           format_path(path_input), dir, edge.i, edge.j);
-        }
-    }
-#endif
-
-    // Check that the path doesn't already exist.
 #ifdef DEBUG
-    for (const auto& [existing_var, _, existing_path] : vars)
-    {
-        release_assert(path_input != existing_path,
+        const auto existing_var = vars.var(v);
+        release_assert(SCIPisFeasLT(scip, SCIPvarGetUbLocal(existing_var), 1.0),
                        "Path {} already exists with value {}, lower bound {}, upper bound {}",
                        format_path(path_input),
                        SCIPgetSolVal(scip, nullptr, existing_var),
                        SCIPvarGetLbLocal(existing_var),
                        SCIPvarGetUbLocal(existing_var));
-    }
 #endif
+        debugln("            Skipping duplicate path {}", format_path(path_input));
+        ++num_duplicate_paths;
+        return false;
+    }
 
     // Check that the path has no duplicate vertices.
 // #ifndef USE_NG_ROUTE_PRICING
@@ -349,14 +443,18 @@ void Problem::add_priced_var(SCIP* scip, Vector<Vertex>&& path_input)
         cost += instance->cost(path_input[idx], path_input[idx + 1]);
     }
 
-    // Create variable data.
-    auto& [var, val, path] = vars.emplace_back();
-
-    // Create and add variable.
+    // Create and add variable. Only name the variable in debug mode since formatting the name is slow. SCIP
+    // generates a name otherwise.
+#ifdef DEBUG
     const auto name = fmt::format("path({})", format_path_with_names(path_input, instance->vertex_name, ","));
+    const char* name_str = name.c_str();
+#else
+    const char* name_str = nullptr;
+#endif
+    SCIP_Var* var = nullptr;
     scip_assert(SCIPcreateVar(scip,
                               &var,
-                              name.c_str(),
+                              name_str,
                               0.0,
                               1.0,
                               cost,
@@ -369,6 +467,9 @@ void Problem::add_priced_var(SCIP* scip, Vector<Vertex>&& path_input)
                               nullptr,
                               nullptr));
     debug_assert(var);
+#ifdef USE_COLUMN_AGING
+    scip_assert(SCIPvarMarkDeletable(var));
+#endif
     scip_assert(SCIPaddPricedVar(scip, var, 1.0));
 
     // Print.
@@ -382,21 +483,19 @@ void Problem::add_priced_var(SCIP* scip, Vector<Vertex>&& path_input)
     // positive reduced cost.
     scip_assert(SCIPchgVarUbLazy(scip, var, 1.0));
 
-    // Add column to customer cover constraints.
-    const auto num_customers = instance->num_customers();
+    // Add column to customer cover constraints. Sort the customers to count the visits without a dense buffer.
     {
-        Vector<SCIP_Real> coeffs(num_customers);
-        for (Size idx = 1; idx < path_input.size() - 1; ++idx)
+        auto& customers = path_customers_buffer;
+        customers.assign(path_input.begin() + 1, path_input.end() - 1);
+        std::sort(customers.begin(), customers.end());
+        for (auto it = customers.begin(); it != customers.end(); )
         {
-            const auto i = path_input[idx];
-            debug_assert(0 <= i && i < num_customers);
-            coeffs[i]++;
+            const auto i = *it;
+            debug_assert(0 <= i && i < instance->num_customers());
+            const auto next = std::find_if(it + 1, customers.end(), [i](const Vertex j) { return j != i; });
+            scip_assert(SCIPaddCoefLinear(scip, customer_cover_conss[i], var, next - it));
+            it = next;
         }
-        for (Vertex i = 0; i < num_customers; ++i)
-            if (coeffs[i])
-            {
-                scip_assert(SCIPaddCoefLinear(scip, customer_cover_conss[i], var, coeffs[i]));
-            }
     }
 
     // Add coefficients to the robust cuts.
@@ -450,10 +549,202 @@ void Problem::add_priced_var(SCIP* scip, Vector<Vertex>&& path_input)
 //     }
 // #endif
 
-    // Store the path.
-    path = std::move(path_input);
+    // Store the variable.
+    [[maybe_unused]] const auto v = vars.add(var, path_input);
+
+    // Check that the path satisifies the branching decisions by walking the path.
+#ifdef DEBUG
+    for (const auto [edge, dir] : SCIPgetActiveEdgeBranchingDecisions(edge_branching_conshdlr))
+    {
+        release_assert(!edge_branching_check_disable_path(edge, dir, vars.path(v)),
+                       "Adding path {} that does not satisfy branching decision {} ({},{})",
+                       format_path(path_input), dir, edge.i, edge.j);
+    }
+#endif
+    return true;
 }
 
+// Add many new path variables at once and return the number of paths that are not duplicates
+Size Problem::add_priced_vars(SCIP* scip, Vector<Vector<Vertex>>& paths)
+{
+    Size num_added = 0;
+    for (auto& path : paths)
+    {
+        num_added += add_priced_var(scip, std::move(path));
+    }
+    paths.clear();
+    return num_added;
+}
+
+// Delete a path variable from the master problem. The variable keeps its entry in the array of variables so that the
+// indices stored by the constraint handlers remain valid, and its path can be added again as a new variable.
+Bool Problem::delete_priced_var(SCIP* scip, const Size v)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(0 <= v && v < static_cast<Size>(vars.size()));
+
+    // Delete the variable.
+    auto var = vars.var(v);
+    debug_assert(!SCIPvarIsDeleted(var));
+    SCIP_Bool deleted = false;
+    scip_assert(SCIPdelVar(scip, var, &deleted));
+    if (!deleted)
+    {
+        return false;
+    }
+
+    // Allow the path to be generated again.
+    vars.remove_from_index(v);
+    vars.val(v) = 0.0;
+    ++num_deleted_vars;
+
+    // Print.
+    debugln("            Deleting column with path {}", format_path_with_names(vars.path(v), instance->vertex_name));
+    return true;
+}
+
+// Get the paths of an integer solution. If customers are covered more than once, in the set covering formulation or
+// by the surplus variables of the dual-optimal inequalities at the root node, they are removed from all but one path,
+// keeping the visit whose removal saves the least, so that the paths partition the customers. By the triangle
+// inequality, the paths stay feasible and the cost does not increase beyond the objective value of the solution.
+Vector<Vector<Vertex>> Problem::get_solution_paths(SCIP* scip, SCIP_Sol* sol, Bool* repaired) const
+{
+    // Get the paths with value 1.
+    Vector<Vector<Vertex>> paths;
+    for (const auto& [var, _, path] : vars)
+        if (SCIPisEQ(scip, SCIPgetSolVal(scip, sol, var), 1.0))
+        {
+            paths.emplace_back(path.begin(), path.end());
+        }
+
+    // Remove the extra visits to over-covered customers.
+    if (repaired)
+    {
+        *repaired = false;
+    }
+#if defined(USE_SET_COVERING) || defined(USE_DUAL_OPTIMAL_INEQUALITIES)
+    {
+        const auto num_customers = instance->num_customers();
+        Vector<Size> num_visits(num_customers);
+        for (const auto& path : paths)
+            for (Size idx = 1; idx < static_cast<Size>(path.size()) - 1; ++idx)
+            {
+                ++num_visits[path[idx]];
+            }
+        for (Vertex i = 0; i < num_customers; ++i)
+            while (num_visits[i] > 1)
+            {
+                // Find the visit whose removal saves the most.
+                Size best_path = -1;
+                Size best_idx = -1;
+                auto best_saving = -std::numeric_limits<Cost>::infinity();
+                for (Size p = 0; p < static_cast<Size>(paths.size()); ++p)
+                {
+                    const auto& path = paths[p];
+                    for (Size idx = 1; idx < static_cast<Size>(path.size()) - 1; ++idx)
+                        if (path[idx] == i)
+                        {
+                            const auto h = path[idx - 1];
+                            const auto j = path[idx + 1];
+                            const auto saving = instance->cost(h, i) + instance->cost(i, j) - instance->cost(h, j);
+                            if (saving > best_saving)
+                            {
+                                best_path = p;
+                                best_idx = idx;
+                                best_saving = saving;
+                            }
+                        }
+                }
+                debug_assert(best_path >= 0);
+                debugln("Removing over-covered customer {} from path {} saving {}",
+                        i, format_path(paths[best_path]), best_saving);
+
+                // Remove the visit.
+                paths[best_path].erase(paths[best_path].begin() + best_idx);
+                --num_visits[i];
+                if (repaired)
+                {
+                    *repaired = true;
+                }
+            }
+
+        // Remove paths without customers.
+        paths.erase(std::remove_if(paths.begin(), paths.end(), [](const auto& path) { return path.size() <= 2; }),
+                    paths.end());
+    }
+#endif
+
+    // Done.
+    return paths;
+}
+
+#if defined(USE_SET_COVERING) || defined(USE_DUAL_OPTIMAL_INEQUALITIES)
+// Store the partition of the incumbent as a new solution if it covers customers more than once. New variables for its
+// paths are only added if allowed, which is only during pricing.
+Bool Problem::repair_solution(SCIP* scip, SCIP_Heur* heur, const Bool add_vars)
+{
+    // Skip if the incumbent is already checked.
+    auto sol = SCIPgetBestSol(scip);
+    if (!sol || SCIPsolGetIndex(sol) == repaired_sol_index)
+    {
+        return false;
+    }
+
+    // Get the repaired paths.
+    Bool repaired = false;
+    const auto paths = get_solution_paths(scip, sol, &repaired);
+    if (!repaired)
+    {
+        repaired_sol_index = SCIPsolGetIndex(sol);
+        return false;
+    }
+
+    // Check that the paths missing from the master problem can be added. New variables can only be added during
+    // pricing and must satisfy the active branching decisions, including the eliminated arcs. Otherwise the incumbent
+    // is checked again later.
+    for (const auto& path : paths)
+        if (vars.find(path) < 0)
+        {
+            if (!add_vars)
+            {
+                return false;
+            }
+            for (const auto [edge, dir] : SCIPgetActiveEdgeBranchingDecisions(edge_branching_conshdlr))
+                if (edge_branching_check_disable_path(edge, dir, path))
+                {
+                    debugln("Postponing the repair of the incumbent because path {} violates branching decision {} "
+                            "({},{})",
+                            format_path(path), dir, edge.i, edge.j);
+                    return false;
+                }
+        }
+    repaired_sol_index = SCIPsolGetIndex(sol);
+
+    // Create the solution. The paths that are not in the master problem are added as new variables.
+    SCIP_Sol* repaired_sol;
+    scip_assert(SCIPcreateSol(scip, &repaired_sol, heur));
+    for (const auto& path : paths)
+    {
+        auto v = vars.find(path);
+        if (v < 0)
+        {
+            add_priced_var(scip, Vector<Vertex>(path));
+            v = vars.size() - 1;
+        }
+        debug_assert(vars.find(path) == v);
+        scip_assert(SCIPsetSolVal(scip, repaired_sol, vars.var(v), 1.0));
+    }
+
+    // Add the solution.
+    SCIP_Bool stored = false;
+    scip_assert(SCIPtrySolFree(scip, &repaired_sol, false, false, true, true, true, &stored));
+    debugln("Repaired solution with objective value {} into {} paths, stored {}",
+            SCIPgetSolOrigObj(scip, sol), paths.size(), stored);
+    return stored;
+}
+#endif
+
 // Add a new robust constraint
 // Pair<SCIP_Result, SCIP_Cons*> Problem::add_robust_constraint(
 //     SCIP* scip,         // SCIP
@@ -802,52 +1093,126 @@ void Problem::update_variable_values(SCIP* scip)
 
     // Update variables values.
     fractional_edges.clear();
-    for (auto& [var, val, path] : vars)
+    for (Size v = 0; v < vars.size(); ++v)
     {
+        // Skip variables deleted from the master problem.
+        const auto var = vars.var(v);
+        auto& val = vars.val(v);
+        if (SCIPvarIsDeleted(var))
+        {
+            val = 0.0;
+            continue;
+        }
+
         // Get the variable value.
         val = SCIPgetSolVal(scip, nullptr, var);
 
         // Store the edges of the path.
         if (SCIPisPositive(scip, val) && !SCIPisIntegral(scip, val))
         {
-            for (Size idx = 0; idx < path.size() - 1; ++idx)
-            {
-                const Edge edge{path[idx], path[idx + 1]};
-                auto& [edge_val, edge_count] = fractional_edges[edge];
-                edge_val += val;
-                ++edge_count;
-            }
+            fractional_edges.add(vars.path(v), val);
         }
     }
 
-    // Delete edges with integer values.
-    for (auto it = fractional_edges.begin(); it != fractional_edges.end();)
-    {
-        const auto val = it->second.first;
-        if (SCIPisIntegral(scip, val))
-        {
-            it = fractional_edges.erase(it);
-        }
-        else
-        {
-            ++it;
-        }
-    }
+    // Keep the edges with fractional value.
+    fractional_edges.finish(scip);
 
     // Print.
 #ifdef PRINT_DEBUG
     if (!fractional_edges.empty())
     {
         println("    Fractional edges:");
-        for (const auto& [edge, pair] : fractional_edges)
+        for (const auto edge : fractional_edges.edges())
         {
-            const auto& [val, count] = pair;
+            const auto val = fractional_edges.val(edge);
+            const auto count = fractional_edges.count(edge);
             println("        ({},{}): val {:.4f}, count {}", edge.i, edge.j, val, count);
         }
     }
 #endif
 }
 
+// Store the final duals and positive columns of the current node for its children
+void Problem::store_node_warm_start(SCIP* scip)
+{
+    // Skip if the duals are not available.
+    if (SCIPgetLPSolstat(scip) != SCIP_LPSOLSTAT_OPTIMAL)
+    {
+        return;
+    }
+
+    // Remove the data of nodes that were pruned before their first pricing call. Every node with data is open, so
+    // there is stale data if there are more entries than open nodes.
+    if (static_cast<SCIP_Longint>(node_warm_starts.size()) > 2 * SCIPgetNNodesLeft(scip))
+    {
+        SCIP_Node** leaves;
+        SCIP_Node** children;
+        SCIP_Node** siblings;
+        int nleaves;
+        int nchildren;
+        int nsiblings;
+        scip_assert(SCIPgetOpenNodesData(scip, &leaves, &children, &siblings, &nleaves, &nchildren, &nsiblings));
+        HashMap<SCIP_Longint, SharedPtr<const NodeWarmStart>> open_node_warm_starts;
+        for (const auto& [nodes, nnodes] : {Pair<SCIP_Node**, int>{leaves, nleaves},
+                                           Pair<SCIP_Node**, int>{children, nchildren},
+                                           Pair<SCIP_Node**, int>{siblings, nsiblings}})
+            for (int idx = 0; idx < nnodes; ++idx)
+            {
+                const auto node = SCIPnodeGetNumber(nodes[idx]);
+                if (const auto it = node_warm_starts.find(node); it != node_warm_starts.end())
+                {
+                    open_node_warm_starts.emplace(node, std::move(it->second));
+                }
+            }
+        debugln("    Removing warm start data of {} pruned nodes",
+                node_warm_starts.size() - open_node_warm_starts.size());
+        node_warm_starts = std::move(open_node_warm_starts);
+    }
+
+    // Store the duals.
+    auto warm_start = std::make_shared<NodeWarmStart>();
+    auto& [duals, paths] = *warm_start;
+    duals.resize(customer_cover_conss.size());
+    for (Size i = 0; i < static_cast<Size>(customer_cover_conss.size()); ++i)
+    {
+        duals[i] = SCIPgetDualsolLinear(scip, customer_cover_conss[i]);
+#ifdef USE_SET_COVERING
+        duals[i] = std::max(duals[i], 0.0);
+#endif
+    }
+
+    // Store the paths with positive value. The values are updated before branching.
+    for (const auto& [var, val, path] : vars)
+        if (SCIPisPositive(scip, val))
+        {
+            paths.emplace_back(path.begin(), path.end());
+        }
+
+    // Share the data with the children.
+    SCIP_Node** children;
+    int nchildren;
+    scip_assert(SCIPgetChildren(scip, &children, &nchildren));
+    for (int idx = 0; idx < nchildren; ++idx)
+    {
+        node_warm_starts[SCIPnodeGetNumber(children[idx])] = warm_start;
+    }
+    debugln("    Storing duals and {} positive paths of node {} for its {} children",
+            paths.size(), SCIPnodeGetNumber(SCIPgetCurrentNode(scip)), nchildren);
+}
+
+// Take the data stored by the parent of the current node
+SharedPtr<const NodeWarmStart> Problem::take_node_warm_start(SCIP* scip)
+{
+    SharedPtr<const NodeWarmStart> warm_start;
+    const auto node = SCIPnodeGetNumber(SCIPgetCurrentNode(scip));
+    if (const auto it = node_warm_starts.find(node); it != node_warm_starts.end())
+    {
+        warm_start = std::move(it->second);
+        node_warm_starts.erase(it);
+    }
+    return warm_start;
+}
+
 // Write master problem LP relaxation to file
 #ifdef DEBUG
 void Problem::write_master(SCIP* scip)
@@ -4,7 +4,9 @@
 // #include "inequalities/separator_two_path.h"
 // #include "inequalities/subset_row_cut.h"
 // #include "inequalities/two_path_labeling_algorithm.h"
+#include "problem/fractional_edges.h"
 #include "problem/instance.h"
+#include "problem/path_variables.h"
 #include "problem/scip.h"
 #include "types/basic_types.h"
 #include "types/edge.h"
@@ -16,11 +18,11 @@
 
 // struct CVRPSEP;
 
-struct PathVariable
+// Final duals and positive columns of a node that has been branched on, shared by its children
+struct NodeWarmStart
 {
-    SCIP_Var* var = nullptr;
-    SCIP_Real val = 0.0;
-    Vector<Vertex> path;
+    Vector<SCIP_Real> duals;          // Dual values of the customer cover constraints
+    Vector<Vector<Vertex>> paths;     // Paths with positive value
 };
 
 // Problem
@@ -31,8 +33,23 @@ struct Problem
     // std::mt19937 rng;                                                        // Random number generator
 
     // Variables
-    Vector<PathVariable> vars;                                               // Array of variables
-    HashMap<Edge, Pair<SCIP_Real, Size>> fractional_edges;                   // Edges with fractional value
+    PathVariables vars;                                                      // Path variables
+    Size num_duplicate_paths;                                                // Number of paths rejected as duplicates
+    Size num_deleted_vars;                                                   // Number of variables deleted by aging
+#ifdef USE_DUAL_OPTIMAL_INEQUALITIES
+    Vector<SCIP_Var*> customer_surplus_vars;                                 // Over-covering of each customer
+#endif
+    FractionalEdges fractional_edges;                                        // Edges with fractional value
+    HashMap<SCIP_Longint, SharedPtr<const NodeWarmStart>> node_warm_starts;  // Data of the parent of each open node
+#ifdef USE_REDUCED_COST_FIXING
+    Vector<Cost> fixing_duals;                                               // Duals of the best Lagrangian bound
+    Cost fixing_bound;                                                       // Best Lagrangian bound of the node
+    SCIP_Longint fixing_node;                                                // Node of the best Lagrangian bound
+#endif
+    Vector<Vertex> path_customers_buffer;                                    // Scratch space for adding variables
+#if defined(USE_SET_COVERING) || defined(USE_DUAL_OPTIMAL_INEQUALITIES)
+    Int64 repaired_sol_index;                                                // Last incumbent checked for over-covering
+#endif
 
     // Constraints
     Vector<SCIP_Cons*> customer_cover_conss;                                 // Each customer must be visited
@@ -69,7 +86,11 @@ struct Problem
     void free(SCIP* scip);
 
     // Add variables
-    void add_priced_var(SCIP* scip, Vector<Vertex>&& path);
+    Bool add_priced_var(SCIP* scip, Vector<Vertex>&& path);
+    Size add_priced_vars(SCIP* scip, Vector<Vector<Vertex>>& paths);
+
+    // Delete variables
+    Bool delete_priced_var(SCIP* scip, const Size v);
 
     // Add constraints
 //     Pair<SCIP_Result, SCIP_Cons*> add_robust_constraint(
@@ -93,6 +114,16 @@ struct Problem
     // Update values of variables
     void update_variable_values(SCIP* scip);
 
+    // Get the paths of an integer solution and store them as a new solution if customers are covered more than once
+    Vector<Vector<Vertex>> get_solution_paths(SCIP* scip, SCIP_Sol* sol, Bool* repaired = nullptr) const;
+#if defined(USE_SET_COVERING) || defined(USE_DUAL_OPTIMAL_INEQUALITIES)
+    Bool repair_solution(SCIP* scip, SCIP_Heur* heur, const Bool add_vars);
+#endif
+
+    // Store the data of the current node for warm starting its children
+    void store_node_warm_start(SCIP* scip);
+    SharedPtr<const NodeWarmStart> take_node_warm_start(SCIP* scip);
+
     // Debug
 #ifdef DEBUG
     void write_master(SCIP* scip);
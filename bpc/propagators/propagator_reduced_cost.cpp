@@ -0,0 +1,112 @@
+// #define PRINT_DEBUG
+
+#include "output/formatting.h"
+#include "problem/debug.h"
+#include "problem/problem.h"
+#include "propagators/propagator_reduced_cost.h"
+
+#ifdef USE_REDUCED_COST_FIXING
+
+// Propagator properties
+#define PROP_NAME     "reduced_cost_fixing"
+#define PROP_DESC     "Fixes path variables to zero using the Lagrangian bound of the labeling pricer"
+#define PROP_PRIORITY 0
+#define PROP_FREQ     1
+#define PROP_DELAY    false
+#define PROP_TIMING   SCIP_PROPTIMING_AFTERLPLOOP
+
+// Fix the path variables that cannot be in a solution better than the incumbent. For any duals, the cost of a
+// solution using a path is at least the Lagrangian bound plus the reduced cost of the path, so a path whose reduced
+// cost under the duals of the best Lagrangian bound of the node is at least the gap to the cutoff bound is useless in
+// the subtree of the node.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+static SCIP_DECL_PROPEXEC(propExecReducedCost)
+{
+    // Check.
+    debug_assert(scip);
+    debug_assert(result);
+
+    // Get problem.
+    const auto& problem = *reinterpret_cast<Problem*>(SCIPgetProbData(scip));
+    const auto& vars = problem.vars;
+    const auto& duals = problem.fixing_duals;
+
+    // Skip if there is no incumbent or no Lagrangian bound of the current node.
+    *result = SCIP_DIDNOTRUN;
+    const auto node = SCIPnodeGetNumber(SCIPgetCurrentNode(scip));
+    const auto cutoff_bound = SCIPgetCutoffbound(scip);
+    if (problem.fixing_node != node || SCIPisInfinity(scip, cutoff_bound))
+    {
+        return SCIP_OKAY;
+    }
+    const auto gap = cutoff_bound - problem.fixing_bound;
+    *result = SCIP_DIDNOTFIND;
+
+    // Fix the path variables.
+    Size nfixedvars = 0;
+    for (Size v = 0; v < vars.size(); ++v)
+    {
+        // Skip variables that are deleted or already fixed to zero.
+        const auto var = vars.var(v);
+        if (SCIPvarIsDeleted(var) || SCIPvarGetUbLocal(var) < 0.5)
+        {
+            continue;
+        }
+
+        // Calculate the reduced cost.
+        const auto path = vars.path(v);
+        auto reduced_cost = SCIPvarGetObj(var);
+        for (Size idx = 1; idx < path.size() - 1; ++idx)
+        {
+            reduced_cost -= duals[path[idx]];
+        }
+
+        // Fix the variable.
+        if (SCIPisGE(scip, reduced_cost, gap))
+        {
+            SCIP_Bool infeasible;
+            SCIP_Bool fixed;
+            SCIP_CALL(SCIPfixVar(scip, var, 0.0, &infeasible, &fixed));
+            debugln("    Fixing path {} with reduced cost {} to zero", format_path(path), reduced_cost);
+            if (infeasible)
+            {
+                *result = SCIP_CUTOFF;
+                return SCIP_OKAY;
+            }
+            nfixedvars += fixed;
+        }
+    }
+    debugln("    Reduced cost fixing fixed {} variables in node {} with Lagrangian bound {} and cutoff bound {}",
+            nfixedvars, node, problem.fixing_bound, cutoff_bound);
+
+    // Done.
+    if (nfixedvars > 0)
+    {
+        *result = SCIP_REDUCEDDOM;
+    }
+    return SCIP_OKAY;
+}
+#pragma GCC diagnostic pop
+
+SCIP_Retcode SCIPincludePropReducedCost(SCIP* scip)
+{
+    // Include propagator.
+    SCIP_Prop* prop = nullptr;
+    SCIP_CALL(SCIPincludePropBasic(scip,
+                                   &prop,
+                                   PROP_NAME,
+                                   PROP_DESC,
+                                   PROP_PRIORITY,
+                                   PROP_FREQ,
+                                   PROP_DELAY,
+                                   PROP_TIMING,
+                                   propExecReducedCost,
+                                   nullptr));
+    debug_assert(prop);
+
+    // Done.
+    return SCIP_OKAY;
+}
+
+#endif
@@ -0,0 +1,6 @@
+#pragma once
+
+#include "problem/scip.h"
+
+// Include reduced cost fixing propagator
+SCIP_Retcode SCIPincludePropReducedCost(SCIP* scip);
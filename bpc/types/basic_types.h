@@ -18,3 +18,8 @@ using Position = Int16;
 using Load = Int16;
 using Time = Int16;
 using Cost = Float;
+#ifdef USE_FLOAT_LABELING
+using LabelCost = float;
+#else
+using LabelCost = Cost;
+#endif
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "problem/debug.h"
+#include "types/basic_types.h"
+#include "types/vector.h"
+#include <type_traits>
+
+// View of a contiguous array owned elsewhere
+template<class T>
+class Span
+{
+    T* data_ = nullptr;
+    Size size_ = 0;
+
+  public:
+    // Constructors and destructor
+    Span(T* data, const Size size) :
+        data_(data),
+        size_(size)
+    {}
+    Span(const Vector<std::remove_const_t<T>>& vector) :
+        data_(vector.data()),
+        size_(static_cast<Size>(vector.size()))
+    {}
+    Span() = default;
+    Span(const Span<T>& other) = default;
+    Span(Span<T>&& other) noexcept = default;
+    ~Span() = default;
+
+    // Assignment
+    Span<T>& operator=(const Span<T>& other) = default;
+    Span<T>& operator=(Span<T>&& other) = default;
+
+    // Getters
+    inline auto data() const { return data_; }
+    inline auto size() const { return size_; }
+    inline auto empty() const { return size_ == 0; }
+    inline T& operator[](const Size idx) const
+    {
+        debug_assert(0 <= idx && idx < size_);
+        return data_[idx];
+    }
+    inline T& front() const { return operator[](0); }
+    inline T& back() const { return operator[](size_ - 1); }
+
+    // Iterators
+    inline auto begin() const { return data_; }
+    inline auto end() const { return data_ + size_; }
+};